@@ -0,0 +1,63 @@
+// Host-side stand-in for the Arduino core, used by the native_sim environment only.
+// It provides just enough of the API for src/main.cpp to compile unchanged on a PC.
+#pragma once
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#define OUTPUT 0x1
+#define INPUT 0x0
+#define HIGH 0x1
+#define LOW 0x0
+
+#define PIN_CAN_STANDBY 40
+#define PIN_CAN_BOOSTEN 4
+
+namespace pongsim {
+// Simulated time in milliseconds, advanced by the simulator once per game tick.
+extern uint32_t sim_millis;
+}
+
+inline void pinMode(int, int) {}
+inline void digitalWrite(int, int) {}
+inline int digitalRead(int) { return LOW; }
+inline void delay(unsigned long) {}
+inline unsigned long millis() { return pongsim::sim_millis; }
+inline unsigned long micros() { return pongsim::sim_millis * 1000UL; }
+
+class HardwareSerial {
+public:
+    void begin(unsigned long) {}
+    explicit operator bool() const { return true; }
+
+    // Output is discarded unless the simulator runs with --verbose, so logging
+    // in onReceive does not dominate the measured decision latency.
+    bool enabled = false;
+
+    size_t print(const char *s) {
+        if (!enabled) return 0;
+        std::fputs(s, stdout);
+        return std::strlen(s);
+    }
+    size_t print(int v) { return printf("%d", v); }
+    size_t println(const char *s = "") { return print(s) + print("\n"); }
+    size_t println(int v) { return print(v) + print("\n"); }
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3))) {
+        if (!enabled) return 0;
+        va_list args;
+        va_start(args, format);
+        int n = std::vprintf(format, args);
+        va_end(args);
+        return n > 0 ? static_cast<size_t>(n) : 0;
+    }
+};
+
+extern HardwareSerial Serial;
+
+void setup();
+void loop();
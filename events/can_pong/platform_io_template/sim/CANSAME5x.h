@@ -0,0 +1,119 @@
+// Host-side stand-in for the Adafruit CANSAME5x driver, used by the native_sim environment only.
+// Every instance is attached to a single in-process loopback bus: the simulator injects server
+// frames and invokes the registered receive callback, and frames written by the bot are queued
+// for the simulator to pick up instead of going out on a wire.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pongsim {
+
+struct CanFrame {
+    long id;
+    uint8_t length;
+    uint8_t data[8];
+};
+
+class LoopbackBus {
+public:
+    // Delivers a frame to the bot by calling its onReceive callback, like the ISR would.
+    void deliver(const CanFrame &frame);
+
+    // Frames the bot transmitted since the last call, in send order.
+    std::vector<CanFrame> &transmitted() { return tx_; }
+
+    void setCallback(void (*callback)(int)) { callback_ = callback; }
+    bool hasCallback() const { return callback_ != nullptr; }
+
+    // Receive side, used by CANSAME5x while the callback runs.
+    const CanFrame &rxFrame() const { return rx_; }
+    uint8_t rxPos = 0;
+
+    // Transmit side, used by CANSAME5x between beginPacket() and endPacket().
+    CanFrame pending{};
+    bool packetOpen = false;
+
+private:
+    void (*callback_)(int) = nullptr;
+    CanFrame rx_{};
+    std::vector<CanFrame> tx_;
+};
+
+LoopbackBus &bus();
+
+}  // namespace pongsim
+
+class CANSAME5x {
+public:
+    bool begin(long baudRate) {
+        baudRate_ = baudRate;
+        return true;
+    }
+    void end() {}
+
+    void onReceive(void (*callback)(int)) { pongsim::bus().setCallback(callback); }
+
+    long packetId() { return pongsim::bus().rxFrame().id; }
+    int packetDlc() { return pongsim::bus().rxFrame().length; }
+
+    int available() {
+        pongsim::LoopbackBus &b = pongsim::bus();
+        return b.rxFrame().length - b.rxPos;
+    }
+
+    int read() {
+        pongsim::LoopbackBus &b = pongsim::bus();
+        if (b.rxPos >= b.rxFrame().length) return -1;
+        return b.rxFrame().data[b.rxPos++];
+    }
+
+    int peek() {
+        pongsim::LoopbackBus &b = pongsim::bus();
+        if (b.rxPos >= b.rxFrame().length) return -1;
+        return b.rxFrame().data[b.rxPos];
+    }
+
+    size_t readBytes(uint8_t *buffer, size_t length) {
+        size_t n = 0;
+        while (n < length) {
+            int c = read();
+            if (c < 0) break;
+            buffer[n++] = static_cast<uint8_t>(c);
+        }
+        return n;
+    }
+
+    int beginPacket(int id, int dlc = -1, bool rtr = false) {
+        (void)dlc;
+        (void)rtr;
+        pongsim::LoopbackBus &b = pongsim::bus();
+        b.pending = pongsim::CanFrame{id, 0, {}};
+        b.packetOpen = true;
+        return 1;
+    }
+
+    size_t write(uint8_t byte) { return write(&byte, 1); }
+
+    size_t write(const uint8_t *buffer, size_t size) {
+        pongsim::LoopbackBus &b = pongsim::bus();
+        if (!b.packetOpen) return 0;
+        size_t n = 0;
+        while (n < size && b.pending.length < sizeof(b.pending.data)) {
+            b.pending.data[b.pending.length++] = buffer[n++];
+        }
+        return n;
+    }
+
+    int endPacket() {
+        pongsim::LoopbackBus &b = pongsim::bus();
+        if (!b.packetOpen) return 0;
+        b.packetOpen = false;
+        b.transmitted().push_back(b.pending);
+        return 1;
+    }
+
+private:
+    long baudRate_ = 0;
+};
@@ -0,0 +1,21 @@
+#include "Arduino.h"
+#include "CANSAME5x.h"
+
+HardwareSerial Serial;
+
+namespace pongsim {
+
+uint32_t sim_millis = 0;
+
+LoopbackBus &bus() {
+    static LoopbackBus instance;
+    return instance;
+}
+
+void LoopbackBus::deliver(const CanFrame &frame) {
+    rx_ = frame;
+    rxPos = 0;
+    if (callback_) callback_(frame.length);
+}
+
+}  // namespace pongsim
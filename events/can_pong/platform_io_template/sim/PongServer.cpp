@@ -0,0 +1,153 @@
+#include "PongServer.h"
+
+namespace pongsim {
+
+namespace {
+
+// Reflection angles from tutorial/media/paddle_reflections.png, bottom zone first:
+// -63.4, -45, -26.5, +26.5, +45, +63.4 degrees, as (cos, sin) in 1/256.
+constexpr int REFLECTION_ZONES = 6;
+constexpr int32_t ZONE_VX[REFLECTION_ZONES] = {114, 181, 229, 229, 181, 114};
+constexpr int32_t ZONE_VY[REFLECTION_ZONES] = {-229, -181, -114, 114, 181, 229};
+
+constexpr int32_t BALL_MAX_X = (FIELD_WIDTH - BALL_SIZE) << 8;
+constexpr int32_t BALL_MAX_Y = (FIELD_HEIGHT - BALL_SIZE) << 8;
+constexpr int32_t PADDLE1_FACE = (PADDLE1_RIGHT_X + 1) << 8;     // first column right of paddle 1
+constexpr int32_t PADDLE2_FACE = (PADDLE2_LEFT_X - BALL_SIZE) << 8; // last ball x left of paddle 2
+
+}  // namespace
+
+PongServer::PongServer(const PongConfig &config)
+    : config_(config), rng_(config.seed ? config.seed : 1) {
+    startGame();
+}
+
+uint32_t PongServer::random() {
+    // xorshift32: cheap and fully reproducible from the configured seed
+    rng_ ^= rng_ << 13;
+    rng_ ^= rng_ >> 17;
+    rng_ ^= rng_ << 5;
+    return rng_;
+}
+
+void PongServer::startGame() {
+    pendingStart_ = true;
+    gameOver_ = false;
+    score_[0] = score_[1] = 0;
+    timeouts_ = 0;
+    paddleY_[0] = paddleY_[1] = PADDLE_START_Y;
+    resetBall();
+}
+
+void PongServer::resetBall() {
+    // Ball spawn area: a vertical strip in the middle of the field
+    ballX_ = ((FIELD_WIDTH - BALL_SIZE) / 2) << 8;
+    ballY_ = static_cast<int32_t>(random() % (FIELD_HEIGHT - BALL_SIZE + 1)) << 8;
+    int zone = static_cast<int>(random() % REFLECTION_ZONES);
+    int sign = (random() & 1) ? 1 : -1;
+    velX_ = sign * ZONE_VX[zone] * config_.ballSpeed;
+    velY_ = ZONE_VY[zone] * config_.ballSpeed;
+    ticksSinceReset_ = 0;
+}
+
+void PongServer::reflect(int player, int ballY) {
+    // The outgoing angle only depends on where the ball centre hits the paddle
+    int offset = ballY + BALL_SIZE / 2 - paddleY_[player];
+    if (offset < 0) offset = 0;
+    if (offset > PADDLE_HEIGHT - 1) offset = PADDLE_HEIGHT - 1;
+    int zone = offset * REFLECTION_ZONES / PADDLE_HEIGHT;
+
+    velX_ = (player == 0 ? 1 : -1) * ZONE_VX[zone] * config_.ballSpeed;
+    velY_ = ZONE_VY[zone] * config_.ballSpeed;
+}
+
+void PongServer::applyPaddleUpdate(int player, int8_t update) {
+    // Only the first frame per tick is read by the server
+    if (player < 0 || player > 1 || paddleUpdated_[player]) return;
+    paddleUpdated_[player] = true;
+    if (update < -1 || update > 1) return;
+
+    int y = paddleY_[player] + update;
+    if (y < 0 || y > PADDLE_MAX_Y) {
+        events_.paddleClamped[player] = true;
+        y = y < 0 ? 0 : PADDLE_MAX_Y;
+    }
+    paddleY_[player] = y;
+}
+
+ServerFrame PongServer::tick() {
+    events_ = TickEvents{};
+    paddleUpdated_[0] = paddleUpdated_[1] = false;
+
+    if (pendingStart_) {
+        pendingStart_ = false;
+        return {static_cast<uint8_t>(ballX()), static_cast<uint8_t>(ballY()), STATE_GAME_START};
+    }
+
+    const int32_t prevX = ballX_;
+    ballX_ += velX_;
+    ballY_ += velY_;
+
+    // Top and bottom borders reflect the ball
+    if (ballY_ < 0) {
+        ballY_ = -ballY_;
+        velY_ = -velY_;
+    } else if (ballY_ > BALL_MAX_Y) {
+        ballY_ = 2 * BALL_MAX_Y - ballY_;
+        velY_ = -velY_;
+    }
+
+    const int by = ballY_ >> 8;
+    int scorer = -1;
+
+    // A paddle can only catch the ball in the tick in which it crosses the paddle face
+    if (velX_ < 0 && prevX >= PADDLE1_FACE && ballX_ < PADDLE1_FACE) {
+        events_.ballArrived[0] = true;
+        if (by + BALL_SIZE > paddleY_[0] && by < paddleY_[0] + PADDLE_HEIGHT) {
+            events_.paddleHit[0] = true;
+            ballX_ = PADDLE1_FACE;
+            reflect(0, by);
+        }
+    } else if (velX_ > 0 && prevX <= PADDLE2_FACE && ballX_ > PADDLE2_FACE) {
+        events_.ballArrived[1] = true;
+        if (by + BALL_SIZE > paddleY_[1] && by < paddleY_[1] + PADDLE_HEIGHT) {
+            events_.paddleHit[1] = true;
+            ballX_ = PADDLE2_FACE;
+            reflect(1, by);
+        }
+    }
+
+    if (ballX_ <= 0) {
+        scorer = 1;
+    } else if (ballX_ >= BALL_MAX_X) {
+        scorer = 0;
+    }
+
+    uint8_t state = STATE_RUNNING;
+    if (scorer >= 0) {
+        score_[scorer]++;
+        if (score_[scorer] >= WINNING_SCORE) {
+            gameOver_ = true;
+            state = scorer == 0 ? STATE_PLAYER1_WON : STATE_PLAYER2_WON;
+        } else {
+            state = scorer == 0 ? STATE_PLAYER1_SCORED : STATE_PLAYER2_SCORED;
+        }
+        resetBall();
+    } else if (++ticksSinceReset_ >= TIMEOUT_SECONDS * config_.ticksPerSecond) {
+        if (++timeouts_ >= MAX_TIMEOUTS) {
+            gameOver_ = true;
+            if (score_[0] == score_[1]) {
+                state = STATE_DRAW;
+            } else {
+                state = score_[0] > score_[1] ? STATE_PLAYER1_WON : STATE_PLAYER2_WON;
+            }
+        } else {
+            state = STATE_TIMEOUT;
+        }
+        resetBall();
+    }
+
+    return {static_cast<uint8_t>(ballX()), static_cast<uint8_t>(ballY()), state};
+}
+
+}  // namespace pongsim
@@ -0,0 +1,100 @@
+// Deterministic model of the CAN Pong game server, following tutorial/can_pong.md:
+// 256x150 field, 6x20 paddles, 6x6 ball, position-dependent paddle reflections,
+// ball reset after 30 s without a score, 5 points or 3 timeouts end the game.
+#pragma once
+
+#include <cstdint>
+
+namespace pongsim {
+
+// Values of byte 2 of the server frame (see "Possible values for game state").
+enum GameStateCode : uint8_t {
+    STATE_GAME_START = 0,
+    STATE_RUNNING = 1,
+    STATE_PLAYER1_SCORED = 2,
+    STATE_PLAYER2_SCORED = 3,
+    STATE_TIMEOUT = 4,
+    STATE_PLAYER1_WON = 5,
+    STATE_PLAYER2_WON = 6,
+    STATE_DRAW = 7,
+};
+
+constexpr int FIELD_WIDTH = 256;
+constexpr int FIELD_HEIGHT = 150;
+constexpr int PADDLE_WIDTH = 6;
+constexpr int PADDLE_HEIGHT = 20;
+constexpr int BALL_SIZE = 6;
+constexpr int PADDLE1_RIGHT_X = 5;   // x of the bottom right corner of paddle 1
+constexpr int PADDLE2_LEFT_X = 250;  // x of the bottom left corner of paddle 2
+constexpr int PADDLE_START_Y = 65;
+constexpr int PADDLE_MAX_Y = FIELD_HEIGHT - PADDLE_HEIGHT;
+constexpr int WINNING_SCORE = 5;
+constexpr int MAX_TIMEOUTS = 3;
+constexpr int TIMEOUT_SECONDS = 30;
+
+// The tutorial does not publish the tick rate or the ball speed, so both are configurable.
+struct PongConfig {
+    uint32_t seed = 1;
+    int ticksPerSecond = 100;
+    int ballSpeed = 2;  // pixels per tick along the direction of travel
+};
+
+struct ServerFrame {
+    uint8_t ballX;
+    uint8_t ballY;
+    uint8_t state;
+};
+
+// Events of the last tick, used by the harness to collect statistics.
+struct TickEvents {
+    bool paddleHit[2] = {false, false};     // ball reflected by player 1 / player 2
+    bool ballArrived[2] = {false, false};   // ball reached the goal line of player 1 / player 2
+    bool paddleClamped[2] = {false, false}; // paddle update would have left 0..130
+};
+
+class PongServer {
+public:
+    explicit PongServer(const PongConfig &config);
+
+    // Resets scores, timeouts and paddles; the next frame carries STATE_GAME_START.
+    void startGame();
+
+    // Applies the first paddle update a player sent during the current tick.
+    // Values outside -1..1 are ignored, like the real server does.
+    void applyPaddleUpdate(int player, int8_t update);
+
+    // Advances the game by one tick and returns the frame to broadcast.
+    ServerFrame tick();
+
+    bool gameOver() const { return gameOver_; }
+    int score(int player) const { return score_[player]; }
+    int paddleY(int player) const { return paddleY_[player]; }
+    int ballX() const { return ballX_ >> 8; }
+    int ballY() const { return ballY_ >> 8; }
+    int ballVelocityX() const { return velX_; }
+    int ballVelocityY() const { return velY_; }
+    const TickEvents &events() const { return events_; }
+
+private:
+    uint32_t random();
+    void resetBall();
+    void reflect(int player, int ballY);
+
+    PongConfig config_;
+    uint32_t rng_;
+    bool pendingStart_ = true;
+    bool gameOver_ = false;
+    int score_[2] = {0, 0};
+    int timeouts_ = 0;
+    int ticksSinceReset_ = 0;
+    int paddleY_[2] = {PADDLE_START_Y, PADDLE_START_Y};
+    bool paddleUpdated_[2] = {false, false};
+    // Ball position and velocity in 1/256 pixel, bottom left corner of the ball.
+    int32_t ballX_ = 0;
+    int32_t ballY_ = 0;
+    int32_t velX_ = 0;
+    int32_t velY_ = 0;
+    TickEvents events_;
+};
+
+}  // namespace pongsim
@@ -0,0 +1,282 @@
+// Host harness for the CAN Pong template: runs the unmodified onReceive() from src/main.cpp
+// against the PongServer model through the loopback CAN shim and reports how the bot plays.
+//
+//   pio run -e native_sim && .pio/build/native_sim/program --matches 10000
+//
+// Options:
+//   --matches N        number of games to play (default 1000)
+//   --seed S           seed of the server and opponent (default 1)
+//   --player 1|2       side the bot plays, must match CANID_PLAYER in main.cpp (default 1)
+//   --speed PX         ball speed in pixels per tick (default 2)
+//   --tps N            server ticks per second, scales the 30 s timeout (default 100)
+//   --opponent-error PX  aiming error of the built-in opponent paddle (default 12)
+//   --verbose          print the bot's Serial output
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "Arduino.h"
+#include "CANSAME5x.h"
+#include "PongServer.h"
+
+using namespace pongsim;
+
+namespace {
+
+constexpr long CANID_SERVER = 0x01;
+constexpr long CANID_PLAYER1 = 0x02;
+constexpr long CANID_PLAYER2 = 0x03;
+
+struct Options {
+    long matches = 1000;
+    uint32_t seed = 1;
+    int player = 0;  // 0 = player 1, 1 = player 2
+    int speed = 2;
+    int tps = 100;
+    int opponentError = 12;
+    bool verbose = false;
+};
+
+// Log-linear latency histogram: 8 sub-buckets per power of two nanoseconds.
+class LatencyHistogram {
+public:
+    void add(uint64_t ns) {
+        ++count_;
+        sum_ += ns;
+        max_ = std::max(max_, ns);
+        ++buckets_[bucketOf(ns)];
+    }
+
+    uint64_t percentile(double p) const {
+        uint64_t rank = static_cast<uint64_t>(p * static_cast<double>(count_));
+        uint64_t seen = 0;
+        for (int i = 0; i < BUCKETS; ++i) {
+            seen += buckets_[i];
+            if (seen > rank) return upperBound(i);
+        }
+        return max_;
+    }
+
+    uint64_t count() const { return count_; }
+    uint64_t max() const { return max_; }
+    double mean() const { return count_ ? static_cast<double>(sum_) / count_ : 0.0; }
+
+private:
+    static constexpr int SUB = 8;
+    static constexpr int BUCKETS = 64 * SUB;
+
+    static int bucketOf(uint64_t ns) {
+        if (ns < SUB) return static_cast<int>(ns);
+        int log2 = 63 - __builtin_clzll(ns);
+        int sub = static_cast<int>((ns >> (log2 - 3)) & (SUB - 1));
+        return std::min((log2 - 2) * SUB + sub, BUCKETS - 1);
+    }
+
+    static uint64_t upperBound(int bucket) {
+        if (bucket < SUB) return bucket;
+        int log2 = bucket / SUB + 2;
+        uint64_t sub = bucket % SUB;
+        return ((SUB + sub + 1) << (log2 - 3)) - 1;
+    }
+
+    uint64_t buckets_[BUCKETS] = {};
+    uint64_t count_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t max_ = 0;
+};
+
+struct Stats {
+    long wins = 0, losses = 0, draws = 0;
+    long pointsFor = 0, pointsAgainst = 0;
+    long arrivals = 0, hits = 0;
+    long frames = 0;
+    long updatesSent = 0;
+    long extraFrames = 0;     // more than one frame in a tick, ignored by the server
+    long invalidUpdates = 0;  // payload not -1, 0 or 1
+    long wrongId = 0;         // frames with an ID other than the bot's player ID
+    long clamped = 0;         // updates that would have moved the paddle out of 0..130
+    LatencyHistogram latency;
+};
+
+// Stand-in for the other team: tracks the predicted intercept with a per-rally aiming error.
+class Opponent {
+public:
+    Opponent(int player, int error, uint32_t seed) : player_(player), error_(error), rng_(seed ^ 0x9E3779B9u) {}
+
+    int8_t update(const PongServer &server) {
+        const bool approaching = player_ == 0 ? server.ballVelocityX() < 0 : server.ballVelocityX() > 0;
+        if (approaching != wasApproaching_) {
+            aim_ = error_ ? static_cast<int>(next() % (2 * error_ + 1)) - error_ : 0;
+            wasApproaching_ = approaching;
+        }
+
+        int target = PADDLE_START_Y + PADDLE_HEIGHT / 2;
+        if (approaching) target = predictIntercept(server) + BALL_SIZE / 2 + aim_;
+
+        int centre = server.paddleY(player_) + PADDLE_HEIGHT / 2;
+        if (target > centre + 1 && server.paddleY(player_) < PADDLE_MAX_Y) return 1;
+        if (target < centre - 1 && server.paddleY(player_) > 0) return -1;
+        return 0;
+    }
+
+private:
+    int predictIntercept(const PongServer &server) const {
+        const int faceX = player_ == 0 ? PADDLE1_RIGHT_X + 1 : PADDLE2_LEFT_X - BALL_SIZE;
+        const int vx = server.ballVelocityX();
+        if (vx == 0) return server.ballY();
+        long ticks = (static_cast<long>(faceX - server.ballX()) << 8) / vx;
+        long y = (static_cast<long>(server.ballY()) << 8) + ticks * server.ballVelocityY();
+        // Fold the straight-line prediction back into the field to account for border bounces
+        const long span = static_cast<long>(FIELD_HEIGHT - BALL_SIZE) << 8;
+        y %= 2 * span;
+        if (y < 0) y += 2 * span;
+        if (y > span) y = 2 * span - y;
+        return static_cast<int>(y >> 8);
+    }
+
+    uint32_t next() {
+        rng_ ^= rng_ << 13;
+        rng_ ^= rng_ >> 17;
+        rng_ ^= rng_ << 5;
+        return rng_;
+    }
+
+    int player_;
+    int error_;
+    uint32_t rng_;
+    int aim_ = 0;
+    bool wasApproaching_ = false;
+};
+
+bool parseOptions(int argc, char **argv, Options &options) {
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!std::strcmp(arg, "--verbose")) {
+            options.verbose = true;
+            continue;
+        }
+        if (!value) {
+            std::fprintf(stderr, "Missing value for %s\n", arg);
+            return false;
+        }
+        if (!std::strcmp(arg, "--matches")) options.matches = std::atol(value);
+        else if (!std::strcmp(arg, "--seed")) options.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 0));
+        else if (!std::strcmp(arg, "--player")) options.player = std::atoi(value) == 2 ? 1 : 0;
+        else if (!std::strcmp(arg, "--speed")) options.speed = std::atoi(value);
+        else if (!std::strcmp(arg, "--tps")) options.tps = std::atoi(value);
+        else if (!std::strcmp(arg, "--opponent-error")) options.opponentError = std::atoi(value);
+        else {
+            std::fprintf(stderr, "Unknown option %s\n", arg);
+            return false;
+        }
+        ++i;
+    }
+    return options.matches > 0 && options.speed > 0 && options.tps > 0;
+}
+
+void playMatch(PongServer &server, Opponent &opponent, const Options &options, Stats &stats) {
+    const int bot = options.player;
+    const int other = 1 - bot;
+    const long botId = bot == 0 ? CANID_PLAYER1 : CANID_PLAYER2;
+    const uint32_t tickMillis = 1000 / options.tps;
+
+    server.startGame();
+    while (true) {
+        ServerFrame frame = server.tick();
+        sim_millis += tickMillis;
+        ++stats.frames;
+
+        const TickEvents &events = server.events();
+        stats.arrivals += events.ballArrived[bot];
+        stats.hits += events.paddleHit[bot];
+
+        CanFrame rx{CANID_SERVER, 3, {frame.ballX, frame.ballY, frame.state}};
+        auto start = std::chrono::steady_clock::now();
+        bus().deliver(rx);
+        auto stop = std::chrono::steady_clock::now();
+        stats.latency.add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count()));
+        loop();
+
+        bool updated = false;
+        for (const CanFrame &tx : bus().transmitted()) {
+            if (tx.id != botId) {
+                ++stats.wrongId;
+                continue;
+            }
+            if (updated) {
+                ++stats.extraFrames;
+                continue;
+            }
+            updated = true;
+            ++stats.updatesSent;
+            int8_t value = tx.length ? static_cast<int8_t>(tx.data[0]) : 0;
+            if (value < -1 || value > 1) ++stats.invalidUpdates;
+            server.applyPaddleUpdate(bot, value);
+        }
+        bus().transmitted().clear();
+        server.applyPaddleUpdate(other, opponent.update(server));
+        stats.clamped += server.events().paddleClamped[bot];
+
+        if (server.gameOver()) break;
+    }
+
+    stats.pointsFor += server.score(bot);
+    stats.pointsAgainst += server.score(other);
+    if (server.score(bot) == server.score(other)) ++stats.draws;
+    else if (server.score(bot) > server.score(other)) ++stats.wins;
+    else ++stats.losses;
+}
+
+void printReport(const Options &options, const Stats &stats, double seconds) {
+    const double matches = static_cast<double>(options.matches);
+    std::printf("Matches: %ld (%.0f matches/s, %ld frames)\n", options.matches, matches / seconds, stats.frames);
+    std::printf("Result:  %ld won, %ld lost, %ld drawn\n", stats.wins, stats.losses, stats.draws);
+    std::printf("Points:  %ld scored, %ld conceded (%.2f / %.2f per match)\n",
+                stats.pointsFor, stats.pointsAgainst, stats.pointsFor / matches, stats.pointsAgainst / matches);
+    std::printf("Hit rate: %.1f%% (%ld of %ld balls returned)\n",
+                stats.arrivals ? 100.0 * stats.hits / stats.arrivals : 0.0, stats.hits, stats.arrivals);
+    std::printf("Decision latency per frame: mean %.0f ns, p50 %llu ns, p99 %llu ns, p99.9 %llu ns, max %llu ns\n",
+                stats.latency.mean(),
+                static_cast<unsigned long long>(stats.latency.percentile(0.50)),
+                static_cast<unsigned long long>(stats.latency.percentile(0.99)),
+                static_cast<unsigned long long>(stats.latency.percentile(0.999)),
+                static_cast<unsigned long long>(stats.latency.max()));
+    std::printf("Updates sent: %ld; ignored extra frames: %ld; invalid values: %ld; wrong ID: %ld; out of range: %ld\n",
+                stats.updatesSent, stats.extraFrames, stats.invalidUpdates, stats.wrongId, stats.clamped);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) return 2;
+    Serial.enabled = options.verbose;
+
+    setup();
+    if (!bus().hasCallback()) {
+        std::fprintf(stderr, "setup() did not register a CAN receive callback\n");
+        return 1;
+    }
+    bus().transmitted().clear();
+
+    PongConfig config;
+    config.seed = options.seed;
+    config.ballSpeed = options.speed;
+    config.ticksPerSecond = options.tps;
+    PongServer server(config);
+    Opponent opponent(1 - options.player, options.opponentError, options.seed);
+    Stats stats;
+
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < options.matches; ++i) {
+        playMatch(server, opponent, options, stats);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    printReport(options, stats, elapsed.count());
+    return 0;
+}
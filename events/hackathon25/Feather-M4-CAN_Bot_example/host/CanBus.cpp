@@ -0,0 +1,315 @@
+// Feather-m4-can_bot_example/host/CanBus.cpp
+/**
+ * @file CanBus.cpp
+ * @brief Bit-level timing model of a classic CAN bus
+ */
+
+#include "CanBus.h"
+
+namespace
+{
+// Fixed-form bits after the CRC: CRC delimiter, ACK slot, ACK delimiter, 7 bits end of frame
+const unsigned FRAME_TAIL_BITS = 10;
+const unsigned INTERMISSION_BITS = 3;
+// Error flag of the detecting node plus the superposed flags of the others, then the delimiter
+const unsigned ERROR_FRAME_BITS = 12 + 8;
+const unsigned SUSPEND_BITS = 8;
+const unsigned ERROR_PASSIVE_COUNT = 128;
+const unsigned BUS_OFF_TEC = 256;
+// Bus-off recovery: 128 occurrences of 11 consecutive recessive bits
+const unsigned RECOVERY_SEQUENCES = 128;
+const unsigned RECOVERY_SEQUENCE_BITS = 11;
+// 19 header bits + 64 data bits + 15 CRC bits, plus a stuff bit after every fourth bit at most
+const unsigned MAX_STUFFED_BITS = 98 + 98 / 4 + 1;
+
+/**
+ * Stuffed bit stream of a frame from start of frame to the end of the CRC
+ */
+struct Encoded
+{
+    uint8_t bits[MAX_STUFFED_BITS];
+    unsigned length;
+    unsigned arbitrationEnd; // First stuffed bit after the RTR bit
+};
+
+void encode(const CanFrame &frame, Encoded &out)
+{
+    uint8_t raw[98];
+    unsigned n = 0;
+    raw[n++] = 0; // Start of frame
+    for (int i = 10; i >= 0; i--)
+        raw[n++] = (frame.id >> i) & 1;
+    raw[n++] = 0; // RTR: data frame
+    const unsigned rawArbitrationEnd = n;
+    raw[n++] = 0; // IDE: standard identifier
+    raw[n++] = 0; // r0
+    uint8_t dlc = frame.dlc > 8 ? 8 : frame.dlc;
+    for (int i = 3; i >= 0; i--)
+        raw[n++] = (dlc >> i) & 1;
+    for (uint8_t byte = 0; byte < dlc; byte++)
+    {
+        for (int i = 7; i >= 0; i--)
+            raw[n++] = (frame.data[byte] >> i) & 1;
+    }
+
+    // CRC-15 over everything so far
+    uint16_t crc = 0;
+    for (unsigned i = 0; i < n; i++)
+    {
+        bool feedback = raw[i] ^ ((crc >> 14) & 1);
+        crc = (crc << 1) & 0x7FFF;
+        if (feedback)
+            crc ^= 0x4599;
+    }
+    for (int i = 14; i >= 0; i--)
+        raw[n++] = (crc >> i) & 1;
+
+    // After five equal bits the transmitter inserts one of the opposite value
+    out.length = 0;
+    out.arbitrationEnd = 0;
+    unsigned run = 0;
+    uint8_t last = 2;
+    for (unsigned i = 0; i < n; i++)
+    {
+        if (i == rawArbitrationEnd)
+            out.arbitrationEnd = out.length;
+        out.bits[out.length++] = raw[i];
+        run = raw[i] == last ? run + 1 : 1;
+        last = raw[i];
+        if (run == 5)
+        {
+            last = !last;
+            out.bits[out.length++] = last;
+            run = 1;
+        }
+    }
+}
+} // namespace
+
+unsigned canFrameBits(const CanFrame &frame)
+{
+    Encoded encoded;
+    encode(frame, encoded);
+    return encoded.length + FRAME_TAIL_BITS + INTERMISSION_BITS;
+}
+
+unsigned canWorstCaseFrameBits(uint8_t dlc)
+{
+    unsigned data = 8 * (dlc > 8 ? 8 : dlc);
+    return data + 47 + (34 + data - 1) / 4;
+}
+
+CanBus::CanBus(uint32_t bitrate) : bitNs_(1000000000ULL / bitrate) {}
+
+int CanBus::addNode(const char *name, unsigned txQueueDepth)
+{
+    Node node;
+    node.stats.name = name;
+    node.depth = txQueueDepth ? txQueueDepth : 1;
+    nodes_.push_back(node);
+    return (int)nodes_.size() - 1;
+}
+
+bool CanBus::transmit(int index, const CanFrame &frame, uint64_t readyNs)
+{
+    Node &node = nodes_[index];
+    if (node.queue.size() >= node.depth)
+    {
+        node.stats.queueFull++;
+        return false;
+    }
+    node.queue.push_back(Queued{frame, readyNs, 0});
+    if (node.queue.size() > node.stats.maxQueued)
+        node.stats.maxQueued = (unsigned)node.queue.size();
+    return true;
+}
+
+bool CanBus::errorPassive(const Node &node) const
+{
+    return node.tec >= ERROR_PASSIVE_COUNT || node.rec >= ERROR_PASSIVE_COUNT;
+}
+
+uint64_t CanBus::readyAt(const Node &node) const
+{
+    if (node.queue.empty())
+        return UINT64_MAX;
+    uint64_t ready = node.queue.front().readyNs;
+    uint64_t earliest = node.suspendUntilNs;
+    if (node.stats.busOff)
+    {
+        // When the recovery completes if the bus stays idle; traffic in between only speeds it up
+        earliest = idleNs_ + (RECOVERY_SEQUENCES - node.recovery) * RECOVERY_SEQUENCE_BITS * bitNs_;
+    }
+    return ready > earliest ? ready : earliest;
+}
+
+uint64_t CanBus::nextStart() const
+{
+    uint64_t earliest = UINT64_MAX;
+    for (const Node &node : nodes_)
+    {
+        uint64_t ready = readyAt(node);
+        if (ready < earliest)
+            earliest = ready;
+    }
+    if (earliest == UINT64_MAX)
+        return UINT64_MAX;
+    return earliest > idleNs_ ? earliest : idleNs_;
+}
+
+void CanBus::transmitted(Node &node, bool error)
+{
+    if (error)
+    {
+        node.tec += 8;
+        node.stats.bitErrors++;
+    }
+    else if (node.tec > 0)
+    {
+        node.tec--;
+    }
+    if (node.tec > node.stats.maxTec)
+        node.stats.maxTec = node.tec;
+    if (node.tec >= BUS_OFF_TEC && !node.stats.busOff)
+    {
+        node.stats.busOff = true;
+        node.stats.busOffs++;
+        node.recovery = 0;
+    }
+}
+
+void CanBus::received(Node &node, bool error)
+{
+    if (error)
+        node.rec++;
+    else if (node.rec > ERROR_PASSIVE_COUNT - 1)
+        node.rec = ERROR_PASSIVE_COUNT - 1; // The standard allows 119 to 127 here
+    else if (node.rec > 0)
+        node.rec--;
+}
+
+void CanBus::recover(Node &node, unsigned sequences)
+{
+    if (!node.stats.busOff)
+        return;
+    node.recovery += sequences;
+    if (node.recovery >= RECOVERY_SEQUENCES)
+    {
+        node.stats.busOff = false;
+        node.tec = 0;
+        node.rec = 0;
+    }
+}
+
+bool CanBus::step(CanDelivery &delivery)
+{
+    uint64_t start = nextStart();
+    if (start == UINT64_MAX)
+        return false;
+
+    // Bus-off nodes count the idle bus since the last frame towards their recovery
+    for (Node &node : nodes_)
+        recover(node, (unsigned)((start - idleNs_) / (RECOVERY_SEQUENCE_BITS * bitNs_)));
+
+    // Everybody ready by now synchronizes on the same start of frame
+    std::vector<int> survivors;
+    std::vector<Encoded> streams(nodes_.size());
+    for (int i = 0; i < (int)nodes_.size(); i++)
+    {
+        if (!nodes_[i].stats.busOff && readyAt(nodes_[i]) <= start)
+        {
+            survivors.push_back(i);
+            encode(nodes_[i].queue.front().frame, streams[i]);
+            nodes_[i].queue.front().attempts++;
+        }
+    }
+    std::vector<int> transmitters = survivors;
+
+    unsigned length = streams[survivors[0]].length;
+    bool errorFrame = false;
+    unsigned bit = 0;
+    for (; bit < length && !errorFrame; bit++)
+    {
+        uint8_t level = 1;
+        for (int i : survivors)
+            level &= streams[i].bits[bit];
+
+        // Nodes sending recessive while the bus is dominant
+        std::vector<int> remaining;
+        bool activeError = false;
+        for (int i : survivors)
+        {
+            if (streams[i].bits[bit] == level)
+            {
+                remaining.push_back(i);
+            }
+            else if (bit < streams[i].arbitrationEnd)
+            {
+                nodes_[i].stats.lostArbitration++;
+            }
+            else
+            {
+                // Same ID, different control or data bits: the node sees a bit error
+                activeError |= !errorPassive(nodes_[i]);
+                transmitted(nodes_[i], true);
+            }
+        }
+        survivors.swap(remaining);
+
+        // An error-passive node signals with recessive bits, which do not disturb the others.
+        // An error-active one sends a dominant error flag and destroys the frame for everyone.
+        if (activeError)
+        {
+            for (int i : survivors)
+                transmitted(nodes_[i], true);
+            errorFrame = true;
+        }
+        length = streams[survivors.empty() ? 0 : survivors[0]].length;
+    }
+
+    unsigned bits = errorFrame ? bit + ERROR_FRAME_BITS + INTERMISSION_BITS : length + FRAME_TAIL_BITS + INTERMISSION_BITS;
+    idleNs_ = start + bits * bitNs_;
+    busyNs_ += bits * bitNs_;
+
+    // Error-passive transmitters let the others go first next time
+    for (int i : transmitters)
+    {
+        if (errorPassive(nodes_[i]))
+            nodes_[i].suspendUntilNs = idleNs_ + SUSPEND_BITS * bitNs_;
+    }
+
+    // Both the frame tail and the error delimiter end in 11 recessive bits with the intermission
+    std::vector<bool> transmitting(nodes_.size(), false);
+    for (int i : transmitters)
+        transmitting[i] = true;
+    for (int i = 0; i < (int)nodes_.size(); i++)
+    {
+        if (nodes_[i].stats.busOff)
+            recover(nodes_[i], 1);
+        else if (!transmitting[i])
+            received(nodes_[i], errorFrame);
+    }
+
+    if (errorFrame)
+    {
+        errorFrames_++;
+        return false;
+    }
+
+    // Identical frames from several nodes go out as one; all of them consider it sent
+    Node &winner = nodes_[survivors[0]];
+    delivery.frame = winner.queue.front().frame;
+    delivery.sender = survivors[0];
+    delivery.queuedNs = winner.queue.front().readyNs;
+    delivery.startNs = start;
+    delivery.endNs = start + (length + FRAME_TAIL_BITS) * bitNs_;
+    delivery.bits = bits;
+    delivery.attempts = winner.queue.front().attempts;
+    for (int i : survivors)
+    {
+        nodes_[i].queue.pop_front();
+        nodes_[i].stats.sent++;
+        transmitted(nodes_[i], false);
+    }
+    return true;
+}
@@ -0,0 +1,147 @@
+// Feather-m4-can_bot_example/host/CanBus.h
+/**
+ * @file CanBus.h
+ * @brief Bit-level timing model of a classic CAN bus
+ *
+ * Models standard (11-bit ID) data frames the way the controllers put them on the wire:
+ * - Every frame is encoded bit by bit including CRC-15 and stuff bits, so the frame length
+ *   depends on the payload just like on the real bus
+ * - All nodes with a pending frame start together when the bus becomes idle and arbitrate
+ *   bit by bit; the lowest ID wins, the others retry at the next idle bus
+ * - Two nodes sending the same ID with different data (e.g. two Move frames) only diverge
+ *   after the arbitration field. That is a bit error: an error frame destroys the frame, the
+ *   transmit error counters of the senders and the receive error counters of the others
+ *   rise, and error-passive nodes have to suspend transmission
+ * - A node whose transmit error counter reaches 256 goes bus-off. It rejoins with both
+ *   counters reset after 128 sequences of 11 recessive bits (idle bus or frame tails), and
+ *   then sends what is left in its FIFO
+ * - Every node has a transmit FIFO of limited depth; a full FIFO rejects the frame
+ *
+ * Time is kept in nanoseconds from the start of the simulation.
+ */
+
+#ifndef CAN_BUS_H
+#define CAN_BUS_H
+
+#include <stdint.h>
+#include <deque>
+#include <string>
+#include <vector>
+
+struct CanFrame
+{
+    uint16_t id;
+    uint8_t dlc;
+    uint8_t data[8];
+};
+
+/**
+ * A frame as received by all other nodes
+ */
+struct CanDelivery
+{
+    CanFrame frame;
+    int sender;
+    uint64_t queuedNs;   // When the sender handed it to its controller
+    uint64_t startNs;    // Start of frame of the successful attempt
+    uint64_t endNs;      // End of frame, when receivers accept it
+    unsigned bits;       // Length of the successful attempt on the wire
+    unsigned attempts;   // 1 + lost arbitrations + error frames
+};
+
+struct CanNodeStats
+{
+    std::string name;
+    unsigned sent = 0;
+    unsigned lostArbitration = 0;
+    unsigned bitErrors = 0;    // Frames destroyed while this node was transmitting
+    unsigned queueFull = 0;    // Frames rejected because the FIFO was full
+    unsigned maxQueued = 0;
+    unsigned maxTec = 0;       // Highest transmit error counter
+    unsigned busOffs = 0;      // Times the node went bus-off
+    bool busOff = false;       // Currently bus-off, waiting for the recovery sequence
+};
+
+/**
+ * Number of bits of a standard data frame on the wire including stuff bits and the
+ * 3 bit intermission, for the given payload.
+ */
+unsigned canFrameBits(const CanFrame &frame);
+
+/**
+ * Upper bound of canFrameBits() over all payloads of a length (maximum stuffing)
+ */
+unsigned canWorstCaseFrameBits(uint8_t dlc);
+
+class CanBus
+{
+public:
+    explicit CanBus(uint32_t bitrate);
+
+    /**
+     * Adds a node with a transmit FIFO of the given depth and returns its index
+     */
+    int addNode(const char *name, unsigned txQueueDepth);
+
+    /**
+     * Hands a frame to the controller of a node. It can go out from readyNs on.
+     *
+     * @return false if the transmit FIFO is full
+     */
+    bool transmit(int node, const CanFrame &frame, uint64_t readyNs);
+
+    /**
+     * Start of the next transmission attempt if no more frames were queued,
+     * UINT64_MAX if nothing is pending
+     */
+    uint64_t nextStart() const;
+
+    /**
+     * Runs the next transmission attempt: arbitration, then either a received frame or an
+     * error frame.
+     *
+     * @param delivery Filled if a frame was received
+     * @return true if a frame was received
+     */
+    bool step(CanDelivery &delivery);
+
+    uint64_t bitNs() const { return bitNs_; }
+    uint64_t busyNs() const { return busyNs_; }
+    unsigned errorFrames() const { return errorFrames_; }
+    unsigned pending(int node) const { return (unsigned)nodes_[node].queue.size(); }
+    const CanNodeStats &stats(int node) const { return nodes_[node].stats; }
+    int nodeCount() const { return (int)nodes_.size(); }
+
+private:
+    struct Queued
+    {
+        CanFrame frame;
+        uint64_t readyNs;
+        unsigned attempts;
+    };
+
+    struct Node
+    {
+        CanNodeStats stats;
+        unsigned depth;
+        std::deque<Queued> queue;
+        unsigned tec = 0;              // Transmit error counter
+        unsigned rec = 0;              // Receive error counter
+        unsigned recovery = 0;         // 11 recessive bit sequences seen while bus-off
+        uint64_t suspendUntilNs = 0;   // Error-passive nodes wait 8 extra bits after transmitting
+    };
+
+    bool errorPassive(const Node &node) const;
+    uint64_t readyAt(const Node &node) const;
+    void transmitted(Node &node, bool error);
+    void received(Node &node, bool error);
+    void recover(Node &node, unsigned sequences);
+
+    uint64_t bitNs_;
+    uint64_t idleNs_ = 0; // End of the last intermission
+    uint64_t busyNs_ = 0;
+    unsigned errorFrames_ = 0;
+    std::vector<Node> nodes_;
+};
+
+#endif
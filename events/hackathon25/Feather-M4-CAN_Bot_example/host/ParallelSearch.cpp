@@ -0,0 +1,209 @@
+// Feather-m4-can_bot_example/host/ParallelSearch.cpp
+/**
+ * @file ParallelSearch.cpp
+ * @brief Multi-threaded version of the game search for host builds
+ */
+
+#include "ParallelSearch.h"
+#include <cstring>
+
+namespace
+{
+const float SCORE_INFINITY = 1.0e9f;
+
+void atomicMin(std::atomic<float> &target, float value)
+{
+    float current = target.load(std::memory_order_relaxed);
+    while (value < current && !target.compare_exchange_weak(current, value, std::memory_order_acq_rel))
+    {
+    }
+}
+
+void atomicMax(std::atomic<float> &target, float value)
+{
+    float current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_acq_rel))
+    {
+    }
+}
+
+/**
+ * Bounds shared by all tasks of one split node
+ */
+struct SplitNode
+{
+    std::atomic<float> alpha;                    // Best completed move value (or the incoming alpha)
+    float beta;
+    std::atomic<float> worst[MAX_OUR_MOVES];     // Running minimum over the replies per move
+    std::atomic<int> remaining[MAX_OUR_MOVES];   // Unfinished reply tasks per move
+    std::atomic<bool> incomplete[MAX_OUR_MOVES]; // Tasks skipped after a beta cutoff
+    std::atomic<bool> refuted[MAX_OUR_MOVES];    // Value is only an upper bound at or below alpha
+};
+
+struct SearchShared
+{
+    WorkStealingPool &pool;
+    TranspositionTable *tt;
+    uint8_t me;
+    std::atomic<uint64_t> nodes;
+};
+
+float parallelNode(SearchShared &shared, const TronState &state, uint8_t depth, float alpha, float beta,
+                   uint8_t *bestMoveOut);
+
+void finishReply(SplitNode &node, uint8_t m)
+{
+    if (node.remaining[m].fetch_sub(1, std::memory_order_acq_rel) == 1 &&
+        !node.incomplete[m].load(std::memory_order_acquire))
+        atomicMax(node.alpha, node.worst[m].load(std::memory_order_acquire));
+}
+
+float parallelNode(SearchShared &shared, const TronState &state, uint8_t depth, float alpha, float beta,
+                   uint8_t *bestMoveOut)
+{
+    shared.nodes.fetch_add(1, std::memory_order_relaxed);
+    const uint8_t me = shared.me;
+
+    if (!(state.alive & (1 << me)))
+        return SCORE_LOSS - depth;
+    if (state.alive == (1 << me))
+        return SCORE_WIN + depth;
+
+    const bool root = bestMoveOut != nullptr;
+    const float alphaOrig = alpha;
+    uint8_t ttMove = DIR_NONE;
+    TTEntry entry;
+    if (shared.tt && shared.tt->probe(searchKey(state, me), entry))
+    {
+        ttMove = entry.move;
+        if (!root && entry.depth == depth)
+        {
+            if (entry.bound == TT_EXACT)
+                return entry.score;
+            if (entry.bound == TT_LOWER && entry.score >= beta)
+                return entry.score;
+            if (entry.bound == TT_UPPER && entry.score <= alpha)
+                return entry.score;
+        }
+    }
+
+    uint8_t moves[MAX_OUR_MOVES];
+    uint8_t moveCount = generateOurMoves(state, me, ttMove, moves);
+    uint8_t replies[MAX_REPLIES][NUM_PLAYERS];
+    uint8_t replyCount = generateReplies(state, me, depth, replies);
+
+    SplitNode node;
+    node.alpha.store(alpha);
+    node.beta = beta;
+    for (uint8_t m = 0; m < moveCount; m++)
+    {
+        node.worst[m].store(SCORE_INFINITY);
+        node.remaining[m].store(replyCount);
+        node.incomplete[m].store(false);
+        node.refuted[m].store(false);
+    }
+
+    WorkStealingPool::TaskGroup group;
+    for (uint8_t m = 0; m < moveCount; m++)
+    {
+        for (uint8_t r = 0; r < replyCount; r++)
+        {
+            shared.pool.run(group, [&, m, r]() {
+                if (node.alpha.load(std::memory_order_acquire) >= node.beta)
+                {
+                    node.incomplete[m].store(true, std::memory_order_release);
+                    finishReply(node, m);
+                    return;
+                }
+                if (node.worst[m].load(std::memory_order_acquire) <= node.alpha.load(std::memory_order_acquire))
+                {
+                    node.refuted[m].store(true, std::memory_order_release);
+                    finishReply(node, m); // Already refuted by another reply
+                    return;
+                }
+
+                uint8_t reply[NUM_PLAYERS];
+                memcpy(reply, replies[r], sizeof(reply));
+                reply[me] = moves[m];
+                TronState child;
+                memcpy(&child, &state, sizeof(TronState));
+                applyMoves(child, reply);
+
+                float a = node.alpha.load(std::memory_order_acquire);
+                float b = node.worst[m].load(std::memory_order_acquire);
+                if (b > node.beta)
+                    b = node.beta;
+
+                float value;
+                if (depth - 1 >= PARALLEL_SPLIT_DEPTH)
+                {
+                    value = parallelNode(shared, child, depth - 1, a, b, nullptr);
+                }
+                else
+                {
+                    SearchContext context = {me, shared.tt, 0};
+                    value = searchValue(context, child, depth - 1, a, b);
+                    shared.nodes.fetch_add(context.nodes, std::memory_order_relaxed);
+                }
+                if (value <= a)
+                    node.refuted[m].store(true, std::memory_order_release);
+                atomicMin(node.worst[m], value);
+                finishReply(node, m);
+            });
+        }
+    }
+    shared.pool.wait(group);
+
+    // On ties, an exactly searched move beats one that was only refuted down to the same bound,
+    // then the earlier move in the ordering wins, independent of thread timing
+    float best = -SCORE_INFINITY;
+    bool bestRefuted = true;
+    uint8_t bestMove = moves[0];
+    for (uint8_t m = 0; m < moveCount; m++)
+    {
+        if (node.incomplete[m].load())
+            continue;
+        float value = node.worst[m].load();
+        bool refuted = node.refuted[m].load();
+        if (value > best || (value == best && bestRefuted && !refuted))
+        {
+            best = value;
+            bestRefuted = refuted;
+            bestMove = moves[m];
+        }
+    }
+
+    if (shared.tt)
+    {
+        entry.score = best;
+        entry.depth = depth;
+        entry.bound = best <= alphaOrig ? TT_UPPER : (best >= beta ? TT_LOWER : TT_EXACT);
+        entry.move = bestMove;
+        shared.tt->store(searchKey(state, me), entry);
+    }
+    if (bestMoveOut)
+        *bestMoveOut = bestMove;
+    return best;
+}
+} // namespace
+
+SearchResult searchParallel(WorkStealingPool &pool, const TronState &state, uint8_t me, uint8_t depth,
+                            TranspositionTable *tt)
+{
+    SearchResult result = {DIR_NONE, SCORE_LOSS, 0};
+    if (!(state.alive & (1 << me)))
+        return result;
+    if (depth > SEARCH_MAX_DEPTH)
+        depth = SEARCH_MAX_DEPTH;
+
+    SearchShared shared{pool, tt, me, {0}};
+    uint8_t first = tt ? 1 : depth;
+    for (uint8_t d = first; d <= depth; d++)
+    {
+        uint8_t move = DIR_NONE;
+        result.score = parallelNode(shared, state, d, -SCORE_INFINITY, SCORE_INFINITY, &move);
+        result.direction = move;
+    }
+    result.nodes = shared.nodes.load();
+    return result;
+}
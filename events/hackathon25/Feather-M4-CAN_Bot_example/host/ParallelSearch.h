@@ -0,0 +1,51 @@
+// Feather-m4-can_bot_example/host/ParallelSearch.h
+/**
+ * @file ParallelSearch.h
+ * @brief Multi-threaded version of the game search for host builds
+ *
+ * Splits every (our move, opponent reply) pair of the root, and of interior nodes with enough
+ * remaining depth, into tasks on a work-stealing pool. Below the split depth, tasks run the
+ * sequential searchValue() from TronSearch.cpp. All threads share one lockless transposition
+ * table and publish alpha-beta bounds through atomics, so a refutation found by one thread
+ * prunes the queued siblings of the others.
+ */
+
+#ifndef PARALLEL_SEARCH_H
+#define PARALLEL_SEARCH_H
+
+#include <memory>
+#include "TronSearch.h"
+#include "WorkStealingPool.h"
+
+/**
+ * Transposition table with heap storage, sized for host memory
+ */
+class HostTranspositionTable : public TranspositionTable
+{
+public:
+    explicit HostTranspositionTable(unsigned log2Slots)
+        : HostTranspositionTable(std::unique_ptr<Slot[]>(new Slot[(size_t)1 << log2Slots]), log2Slots) {}
+
+private:
+    HostTranspositionTable(std::unique_ptr<Slot[]> storage, unsigned log2Slots)
+        : TranspositionTable(storage.get(), (size_t)1 << log2Slots), storage_(std::move(storage)) {}
+
+    std::unique_ptr<Slot[]> storage_;
+};
+
+// Interior nodes with at least this remaining depth are split into tasks as well
+const uint8_t PARALLEL_SPLIT_DEPTH = 3;
+
+/**
+ * Iterative deepening search from the root position on all threads of the pool
+ *
+ * @param pool Thread pool, the calling thread takes part in the search
+ * @param state Current position
+ * @param me Our player index (player ID - 1)
+ * @param depth Number of ticks to look ahead
+ * @param tt Optional transposition table shared by all threads
+ */
+SearchResult searchParallel(WorkStealingPool &pool, const TronState &state, uint8_t me, uint8_t depth,
+                            TranspositionTable *tt);
+
+#endif
@@ -0,0 +1,283 @@
+// Feather-m4-can_bot_example/host/TronEvalApi.cpp
+/**
+ * @file TronEvalApi.cpp
+ * @brief C interface for scoring large batches of recorded positions on a PC
+ */
+
+#include "TronEvalApi.h"
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "Evaluation.h"
+#include "TronSearch.h"
+#include "TunedWeights.h"
+
+static_assert(sizeof(tron_position) == 2064, "tron_position is part of the ABI");
+static_assert(sizeof(tron_scores) == 32, "tron_scores is part of the ABI");
+static_assert(sizeof(EvalWeights) == EVAL_WEIGHT_COUNT * sizeof(float), "weights are passed as a float array");
+
+namespace
+{
+// Positions a worker claims at once; small enough to balance uneven search times
+const size_t CHUNK = 16;
+const float SEARCH_WINDOW = 1.0e9f;
+
+/**
+ * Scratch memory of one worker, allocated once per batch
+ */
+struct Worker
+{
+    TronState state;
+    std::unique_ptr<TranspositionTable::Slot[]> slots;
+    std::unique_ptr<TranspositionTable> tt;
+};
+
+void unpack(const tron_position &position, TronState &state, uint8_t heads[NUM_PLAYERS][2])
+{
+    for (int x = 0; x < GRID_WIDTH; x++)
+    {
+        for (int y = 0; y < GRID_HEIGHT; y++)
+        {
+            int cell = x * GRID_HEIGHT + y;
+            state.grid[x][y] = (position.cells[cell >> 1] >> ((cell & 1) * 4)) & 0x0F;
+        }
+    }
+    state.alive = 0;
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+    {
+        state.x[i] = heads[i][0] = position.head_x[i];
+        state.y[i] = heads[i][1] = position.head_y[i];
+        state.heading[i] = position.heading[i];
+        if (position.head_x[i] != NO_POSITION)
+            state.alive |= 1 << i;
+    }
+    state.hash = computeHash(state);
+}
+
+bool valid(const tron_position &position)
+{
+    if (position.me >= NUM_PLAYERS)
+        return false;
+    for (uint8_t byte : position.reserved)
+    {
+        if (byte)
+            return false;
+    }
+    for (uint8_t byte : position.cells)
+    {
+        if ((byte & 0x0F) > NUM_PLAYERS || (byte >> 4) > NUM_PLAYERS)
+            return false;
+    }
+    for (int i = 0; i < NUM_PLAYERS; i++)
+    {
+        bool dead = position.head_x[i] == NO_POSITION;
+        if (!dead && (position.head_x[i] >= GRID_WIDTH || position.head_y[i] >= GRID_HEIGHT))
+            return false;
+        if (!dead && (position.heading[i] < DIR_UP || position.heading[i] > DIR_LEFT))
+            return false;
+    }
+    return true;
+}
+
+uint8_t bestOf(const tron_scores &scores)
+{
+    uint8_t best = DIR_NONE;
+    for (uint8_t dir = DIR_UP; dir <= DIR_LEFT; dir++)
+    {
+        if (scores.score[dir - 1] != TRON_EVAL_NO_SCORE && (best == DIR_NONE || scores.score[dir - 1] > scores.score[best - 1]))
+            best = dir;
+    }
+    return best;
+}
+
+void scoreArea(const TronState &state, uint8_t me, tron_scores &scores)
+{
+    for (uint8_t dir = DIR_UP; dir <= DIR_LEFT; dir++)
+    {
+        uint8_t nx = wrapX(state.x[me] + dx[dir - 1]);
+        uint8_t ny = wrapY(state.y[me] + dy[dir - 1]);
+        scores.score[dir - 1] = state.grid[nx][ny] ? -1.0f : (float)calculateAccessibleArea(state.grid, nx, ny);
+    }
+    scores.best = bestOf(scores);
+}
+
+void scoreMove(const TronState &state, const uint8_t heads[NUM_PLAYERS][2], uint8_t me, const EvalWeights &weights,
+               tron_scores &scores)
+{
+    for (uint8_t dir = DIR_UP; dir <= DIR_LEFT; dir++)
+        scores.score[dir - 1] = evaluateMove(state.grid, heads, me, state.heading[me], dir, weights);
+    scores.best = chooseMove(state.grid, heads, me, state.heading[me], weights);
+}
+
+/**
+ * Full-window value of every root move, so each score is exact and independent of the others
+ */
+void scoreSearch(const TronState &state, uint8_t me, uint8_t depth, TranspositionTable *tt, tron_scores &scores)
+{
+    SearchContext context = {me, tt, 0};
+    uint8_t replies[MAX_REPLIES][NUM_PLAYERS];
+    uint8_t replyCount = generateReplies(state, me, depth, replies);
+    TronState child;
+
+    for (uint8_t dir = DIR_UP; dir <= DIR_LEFT; dir++)
+    {
+        if (isReverse(dir, state.heading[me]))
+            continue;
+        float worst = SEARCH_WINDOW;
+        for (uint8_t r = 0; r < replyCount; r++)
+        {
+            memcpy(&child, &state, sizeof(TronState));
+            replies[r][me] = dir;
+            applyMoves(child, replies[r]);
+            float value = searchValue(context, child, depth - 1, -SEARCH_WINDOW, worst);
+            if (value < worst)
+                worst = value;
+        }
+        scores.score[dir - 1] = worst;
+    }
+    scores.best = bestOf(scores);
+    scores.nodes = context.nodes;
+}
+
+void scoreOne(Worker &worker, const tron_position &position, const tron_eval_options &options,
+              const EvalWeights &weights, tron_scores &scores)
+{
+    memset(&scores, 0, sizeof(scores));
+    for (int i = 0; i < 4; i++)
+        scores.score[i] = TRON_EVAL_NO_SCORE;
+
+    uint8_t heads[NUM_PLAYERS][2];
+    unpack(position, worker.state, heads);
+    uint8_t me = position.me;
+    if (!(worker.state.alive & (1 << me)))
+        return;
+
+    switch (options.kind)
+    {
+    case TRON_EVAL_AREA:
+        scoreArea(worker.state, me, scores);
+        break;
+    case TRON_EVAL_MOVE:
+        scoreMove(worker.state, heads, me, weights, scores);
+        break;
+    default:
+        scoreSearch(worker.state, me, (uint8_t)options.search_depth, worker.tt.get(), scores);
+        break;
+    }
+}
+} // namespace
+
+extern "C" uint32_t tron_eval_version(void)
+{
+    return TRON_EVAL_API_VERSION;
+}
+
+extern "C" void tron_eval_default_options(tron_eval_options *options)
+{
+    memset(options, 0, sizeof(*options));
+    options->struct_size = sizeof(*options);
+    options->kind = TRON_EVAL_MOVE;
+    options->search_depth = 4;
+}
+
+extern "C" void tron_eval_pack_cells(tron_position *position, const uint8_t *grid)
+{
+    for (int cell = 0; cell < GRID_WIDTH * GRID_HEIGHT; cell += 2)
+        position->cells[cell >> 1] = (grid[cell] & 0x0F) | (grid[cell + 1] & 0x0F) << 4;
+}
+
+extern "C" int tron_eval_batch(const tron_position *positions, size_t count, const tron_eval_options *options,
+                               tron_scores *scores)
+{
+    if (!options || options->struct_size < sizeof(tron_eval_options) || (count && (!positions || !scores)))
+        return TRON_EVAL_INVALID_ARGUMENT;
+    if (options->kind > TRON_EVAL_SEARCH ||
+        (options->kind == TRON_EVAL_SEARCH && (options->search_depth < 1 || options->search_depth > SEARCH_MAX_DEPTH)) ||
+        options->tt_bits > 30)
+        return TRON_EVAL_INVALID_ARGUMENT;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!valid(positions[i]))
+            return TRON_EVAL_INVALID_ARGUMENT;
+    }
+
+    EvalWeights weights = TUNED_WEIGHTS;
+    if (options->weights)
+        memcpy(&weights, options->weights, sizeof(EvalWeights));
+
+    unsigned threads = options->threads ? options->threads : std::thread::hardware_concurrency();
+    if (!threads)
+        threads = 1;
+    if (threads > (count + CHUNK - 1) / CHUNK)
+        threads = (unsigned)((count + CHUNK - 1) / CHUNK);
+    if (!threads)
+        return TRON_EVAL_OK;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    try
+    {
+        for (unsigned t = 0; t < threads; t++)
+        {
+            std::unique_ptr<Worker> worker(new Worker());
+            if (options->kind == TRON_EVAL_SEARCH)
+            {
+                size_t slots = (size_t)1 << (options->tt_bits ? options->tt_bits : 16);
+                worker->slots.reset(new TranspositionTable::Slot[slots]);
+                worker->tt.reset(new TranspositionTable(worker->slots.get(), slots));
+                worker->tt->clear();
+            }
+            workers.push_back(std::move(worker));
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        return TRON_EVAL_OUT_OF_MEMORY;
+    }
+
+    // Workers only start once all threads exist, so a failed start leaves the scores untouched
+    std::atomic<bool> started(false);
+    std::atomic<bool> canceled(false);
+    std::atomic<size_t> next(0);
+    auto work = [&](Worker &worker) {
+        while (!started.load())
+            std::this_thread::yield();
+        if (canceled.load())
+            return;
+        for (size_t begin; (begin = next.fetch_add(CHUNK)) < count;)
+        {
+            size_t end = begin + CHUNK < count ? begin + CHUNK : count;
+            for (size_t i = begin; i < end; i++)
+                scoreOne(worker, positions[i], *options, weights, scores[i]);
+        }
+    };
+
+    // No exception may cross the C interface
+    std::vector<std::thread> pool;
+    int status = TRON_EVAL_OK;
+    try
+    {
+        pool.reserve(threads - 1);
+        for (unsigned t = 1; t < threads; t++)
+            pool.emplace_back(work, std::ref(*workers[t]));
+    }
+    catch (const std::system_error &)
+    {
+        status = TRON_EVAL_THREAD_ERROR;
+    }
+    catch (const std::bad_alloc &)
+    {
+        status = TRON_EVAL_OUT_OF_MEMORY;
+    }
+    canceled = status != TRON_EVAL_OK;
+    started = true;
+    work(*workers[0]);
+    for (std::thread &thread : pool)
+        thread.join();
+    return status;
+}
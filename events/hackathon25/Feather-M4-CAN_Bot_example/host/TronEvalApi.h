@@ -0,0 +1,111 @@
+/* Feather-m4-can_bot_example/host/TronEvalApi.h */
+/**
+ * @file TronEvalApi.h
+ * @brief C interface for scoring large batches of recorded positions on a PC
+ *
+ * Scores positions with the unchanged firmware kernels (calculateAccessibleArea, evaluateMove,
+ * the game search) for blunder analysis and training data. The interface is plain C, so it can
+ * be loaded from Python (ctypes/cffi) or any other language:
+ *
+ *   g++ -std=gnu++17 -O2 -fPIC -shared -pthread -DTRON_HOST -Iinclude -Ihost \
+ *       src/TronCore.cpp src/Evaluation.cpp src/TronSearch.cpp src/Board.cpp host/TronEvalApi.cpp -o libtroneval.so
+ *
+ * A batch is one contiguous array of tron_position records. It is split over worker threads,
+ * which allocate their scratch memory once per call and nothing per position.
+ *
+ * ABI rules: structs only grow at the end, options carry their own size, and
+ * TRON_EVAL_API_VERSION changes whenever a layout or meaning changes.
+ */
+
+#ifndef TRON_EVAL_API_H
+#define TRON_EVAL_API_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TRON_EVAL_API_VERSION 2
+
+/* Score of a direction that the kernel does not rate, e.g. a backwards move in a search */
+#define TRON_EVAL_NO_SCORE (-3.0e38f)
+
+/**
+ * One board as seen by a player, 2064 bytes
+ */
+typedef struct tron_position
+{
+    uint8_t cells[2048];  /* 4 bits per cell: 0 = free, 1-4 = owner, 5-15 invalid; cell (x, y) is nibble x * 64 + y, low nibble first */
+    uint8_t head_x[4];    /* Head per player, 255 for dead players */
+    uint8_t head_y[4];
+    uint8_t heading[4];   /* Last step direction per player: 1 = UP, 2 = RIGHT, 3 = DOWN, 4 = LEFT */
+    uint8_t me;           /* Player to score, 0-3 */
+    uint8_t reserved[3];  /* Must be zero, checked so later versions can use them */
+} tron_position;
+
+/**
+ * Scores of one position
+ */
+typedef struct tron_scores
+{
+    float score[4];      /* Per direction UP, RIGHT, DOWN, LEFT */
+    uint8_t best;        /* Direction the firmware would play, 0 if none */
+    uint8_t reserved[3];
+    uint64_t nodes;      /* Search nodes, 0 for the other kinds */
+} tron_scores;
+
+typedef enum tron_eval_kind
+{
+    TRON_EVAL_AREA = 0,   /* calculateAccessibleArea from the target cell, -1 if it is occupied */
+    TRON_EVAL_MOVE = 1,   /* evaluateMove with the given weights; best is chooseMove */
+    TRON_EVAL_SEARCH = 2  /* Exact search value of each move after search_depth ticks */
+} tron_eval_kind;
+
+typedef struct tron_eval_options
+{
+    uint32_t struct_size;    /* sizeof(tron_eval_options) */
+    uint32_t kind;           /* tron_eval_kind */
+    uint32_t threads;        /* Worker threads, 0 = all hardware threads */
+    uint32_t search_depth;   /* TRON_EVAL_SEARCH only, 1-16 */
+    uint32_t tt_bits;        /* TRON_EVAL_SEARCH only: log2 of the table slots per thread, 0 = 16 */
+    const float *weights;    /* TRON_EVAL_MOVE only: 7 weights in EvalWeights order, NULL = firmware weights */
+} tron_eval_options;
+
+typedef enum tron_eval_status
+{
+    TRON_EVAL_OK = 0,
+    TRON_EVAL_INVALID_ARGUMENT = 1,
+    TRON_EVAL_OUT_OF_MEMORY = 2,
+    TRON_EVAL_THREAD_ERROR = 3   /* A worker thread could not be started; no scores were written */
+} tron_eval_status;
+
+/**
+ * Returns TRON_EVAL_API_VERSION of the loaded library
+ */
+uint32_t tron_eval_version(void);
+
+/**
+ * Fills options with the defaults (TRON_EVAL_MOVE, all threads, depth 4)
+ */
+void tron_eval_default_options(tron_eval_options *options);
+
+/**
+ * Packs an owner grid (64 * 64 bytes, index x * 64 + y) into a position
+ */
+void tron_eval_pack_cells(tron_position *position, const uint8_t *grid);
+
+/**
+ * Scores count positions into scores[0..count-1]. Thread-safe; calls may run concurrently.
+ *
+ * @return tron_eval_status
+ */
+int tron_eval_batch(const tron_position *positions, size_t count, const tron_eval_options *options,
+                    tron_scores *scores);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,94 @@
+// Feather-m4-can_bot_example/host/TronSim.cpp
+/**
+ * @file TronSim.cpp
+ * @brief Host simulation of complete games between four move policies
+ */
+
+#include "TronSim.h"
+#include "Evaluation.h"
+
+namespace
+{
+uint32_t nextRandom(uint32_t &rng)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+uint8_t randomSafeMove(const TronState &state, uint8_t player, uint32_t &rng)
+{
+    uint8_t options[3];
+    uint8_t count = 0;
+    for (uint8_t dir = DIR_UP; dir <= DIR_LEFT; dir++)
+    {
+        if (isReverse(dir, state.heading[player]))
+            continue;
+        if (!state.grid[wrapX(state.x[player] + dx[dir - 1])][wrapY(state.y[player] + dy[dir - 1])])
+            options[count++] = dir;
+    }
+    return count ? options[nextRandom(rng) % count] : state.heading[player];
+}
+} // namespace
+
+void headsOf(const TronState &state, uint8_t heads[NUM_PLAYERS][2])
+{
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+    {
+        heads[i][0] = state.x[i];
+        heads[i][1] = state.y[i];
+    }
+}
+
+SimPolicy weightedPolicy(const EvalWeights &weights)
+{
+    return [weights](const TronState &state, uint8_t me) {
+        uint8_t heads[NUM_PLAYERS][2];
+        headsOf(state, heads);
+        return chooseMove(state.grid, heads, me, state.heading[me], weights);
+    };
+}
+
+SimGameResult playGame(const SimPolicy policies[NUM_PLAYERS], const SimOptions &options,
+                       const std::function<void(const TronState &state, const uint8_t moves[NUM_PLAYERS])> &observer)
+{
+    SimGameResult result = {{0, 0, 0, 0}, 0};
+    uint32_t rng = options.seed ? options.seed : 1;
+    uint8_t openingTicks = options.maxOpeningTicks ? nextRandom(rng) % (options.maxOpeningTicks + 1) : 0;
+
+    TronState state;
+    initTronState(state);
+    uint8_t deadCount = 0;
+
+    while (__builtin_popcount(state.alive) > 1 && result.ticks < options.maxTicks)
+    {
+        uint8_t moves[NUM_PLAYERS] = {DIR_NONE, DIR_NONE, DIR_NONE, DIR_NONE};
+        for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+        {
+            if (!(state.alive & (1 << i)))
+                continue;
+            moves[i] = result.ticks < openingTicks ? randomSafeMove(state, i, rng) : policies[i](state, i);
+        }
+
+        uint8_t died = applyMoves(state, moves);
+        result.ticks++;
+        if (observer)
+            observer(state, moves);
+
+        // Players dying in the same tick share the lower placement
+        for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+        {
+            if (died & (1 << i))
+                result.points[i] = deadCount + 1;
+        }
+        deadCount += __builtin_popcount(died);
+    }
+
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+    {
+        if (state.alive & (1 << i))
+            result.points[i] = deadCount + 1;
+    }
+    return result;
+}
@@ -0,0 +1,73 @@
+// Feather-m4-can_bot_example/host/TronSim.h
+/**
+ * @file TronSim.h
+ * @brief Host simulation of complete games between four move policies
+ *
+ * Applies the server rules from TronCore to four policies tick by tick and awards points
+ * like the gamefinish message: the first player to die gets 1 point, the second 2, and so
+ * on; players dying in the same tick share the lower number of points.
+ */
+
+#ifndef TRON_SIM_H
+#define TRON_SIM_H
+
+#include <functional>
+#include <memory>
+#include <stdint.h>
+#include "EvalWeights.h"
+#include "TronCore.h"
+
+/**
+ * Picks the next direction for player me
+ */
+typedef std::function<uint8_t(const TronState &state, uint8_t me)> SimPolicy;
+
+struct SimOptions
+{
+    uint32_t seed = 1;
+    uint8_t maxOpeningTicks = 12; // Up to this many random (but safe) moves at the start
+    uint16_t maxTicks = 4096;     // Safety limit; the board is full long before
+};
+
+struct SimGameResult
+{
+    uint8_t points[NUM_PLAYERS];
+    uint16_t ticks;
+};
+
+/**
+ * Copies the head positions of a state into the layout of the GameState message
+ */
+void headsOf(const TronState &state, uint8_t heads[NUM_PLAYERS][2]);
+
+/**
+ * Policy that plays chooseMove() from Evaluation.cpp with the given weights
+ */
+SimPolicy weightedPolicy(const EvalWeights &weights);
+
+/**
+ * Policy that plays a strategy from Strategy.h, e.g. one of BasicStrategies.h. The strategy
+ * keeps state across ticks, so every game needs its own policy.
+ */
+template <typename Strategy>
+SimPolicy strategyPolicy()
+{
+    std::shared_ptr<Strategy> strategy = std::make_shared<Strategy>();
+    return [strategy](const TronState &state, uint8_t me) {
+        uint8_t heads[NUM_PLAYERS][2];
+        headsOf(state, heads);
+        return strategy->decide(state.grid, heads, state.heading, me); // 0 keeps the heading
+    };
+}
+
+/**
+ * Plays one game. A seeded random opening makes games with the same policies differ.
+ *
+ * @param policies Policy per player
+ * @param options Seed and limits
+ * @param observer Optional callback after every tick, e.g. for consistency checks
+ */
+SimGameResult playGame(const SimPolicy policies[NUM_PLAYERS], const SimOptions &options,
+                       const std::function<void(const TronState &state, const uint8_t moves[NUM_PLAYERS])> &observer = nullptr);
+
+#endif
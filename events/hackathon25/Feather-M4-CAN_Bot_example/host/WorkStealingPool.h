@@ -0,0 +1,197 @@
+// Feather-m4-can_bot_example/host/WorkStealingPool.h
+/**
+ * @file WorkStealingPool.h
+ * @brief Work-stealing thread pool for host builds
+ *
+ * Every thread owns a task deque. Tasks spawned by a thread go to the back of its own deque
+ * and are taken LIFO (depth-first, cache friendly); idle threads steal FIFO from the front of
+ * the other deques, which hands out the largest remaining subtrees first. Waiting on a task
+ * group executes pending tasks instead of blocking, so tasks can spawn and wait on nested groups.
+ */
+
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkStealingPool
+{
+public:
+    /**
+     * Counts the unfinished tasks spawned into it
+     */
+    class TaskGroup
+    {
+    public:
+        TaskGroup() : pending_(0) {}
+        bool done() const { return pending_.load(std::memory_order_acquire) == 0; }
+
+    private:
+        friend class WorkStealingPool;
+        std::atomic<int> pending_;
+    };
+
+    /**
+     * @param threads Total number of threads working on tasks, including the thread that
+     *                calls wait(); 1 runs everything on the calling thread
+     */
+    explicit WorkStealingPool(unsigned threads)
+        : queues_(threads ? threads : 1), stop_(false), queued_(0)
+    {
+        for (unsigned i = 0; i < queues_.size(); i++)
+            queues_[i].reset(new Queue());
+        for (unsigned i = 1; i < queues_.size(); i++)
+            threads_.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+
+    ~WorkStealingPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            stop_.store(true);
+        }
+        wake_.notify_all();
+        for (std::thread &thread : threads_)
+            thread.join();
+    }
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    unsigned size() const { return (unsigned)queues_.size(); }
+
+    /**
+     * Queues a task on the calling thread's deque
+     */
+    void run(TaskGroup &group, std::function<void()> task)
+    {
+        group.pending_.fetch_add(1, std::memory_order_relaxed);
+        Queue &queue = *queues_[self()];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(Task{std::move(task), &group});
+        }
+        queued_.fetch_add(1, std::memory_order_release);
+        if (threads_.size())
+        {
+            // Taking the lock orders this against a worker that is just about to sleep
+            { std::lock_guard<std::mutex> lock(sleepMutex_); }
+            wake_.notify_one();
+        }
+    }
+
+    /**
+     * Runs pending tasks (own first, then stolen) until every task of the group finished
+     */
+    void wait(TaskGroup &group)
+    {
+        const unsigned index = self();
+        while (!group.done())
+        {
+            if (!runOne(index))
+                std::this_thread::yield();
+        }
+    }
+
+private:
+    struct Task
+    {
+        std::function<void()> function;
+        TaskGroup *group;
+    };
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    /**
+     * Deque index of the calling thread; threads outside the pool share slot 0
+     */
+    unsigned self() const
+    {
+        return workerIndex() >= 0 && workerPool() == this ? (unsigned)workerIndex() : 0;
+    }
+
+    static int &workerIndex()
+    {
+        static thread_local int index = -1;
+        return index;
+    }
+
+    static const WorkStealingPool *&workerPool()
+    {
+        static thread_local const WorkStealingPool *pool = nullptr;
+        return pool;
+    }
+
+    bool runOne(unsigned index)
+    {
+        Task task;
+        if (!popOwn(index, task) && !steal(index, task))
+            return false;
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        task.function();
+        task.group->pending_.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+
+    bool popOwn(unsigned index, Task &task)
+    {
+        Queue &queue = *queues_[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+            return false;
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(unsigned index, Task &task)
+    {
+        const unsigned count = (unsigned)queues_.size();
+        for (unsigned offset = 1; offset < count; offset++)
+        {
+            Queue &queue = *queues_[(index + offset) % count];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty())
+                continue;
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    void workerLoop(unsigned index)
+    {
+        workerIndex() = (int)index;
+        workerPool() = this;
+        while (!stop_.load(std::memory_order_acquire))
+        {
+            if (runOne(index))
+                continue;
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            wake_.wait(lock, [this] {
+                return stop_.load(std::memory_order_acquire) || queued_.load(std::memory_order_acquire) > 0;
+            });
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> threads_;
+    std::atomic<bool> stop_;
+    std::atomic<int> queued_;
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+};
+
+#endif
@@ -0,0 +1,247 @@
+// Feather-m4-can_bot_example/host/board_check.cpp
+/**
+ * @file board_check.cpp
+ * @brief Checks Board make/unmake against applyMoves() in self-play games and times both
+ *
+ * Three checks, each counting mismatches:
+ * - Replay: every tick of simulated games is made on a Board and compared with the simulator's
+ *   TronState (grid, heads, headings, alive mask, deaths, hash). Every BOARD_MAX_PLIES ticks
+ *   the board is unmade back to its start, compared with every state on the way.
+ * - Tree: random search trees below positions sampled from the games, each child compared with
+ *   a copy of the parent after applyMoves(), and the parent compared again after unmake().
+ * - Timing of make() + unmake() against copying the state and applyMoves().
+ *
+ *   pio run -e native_board_check && .pio/build/native_board_check/program --games 20
+ *
+ * Options:
+ *   --games N        games to play (default 20)
+ *   --seed S         seed of the first game (default 1)
+ *   --depth D        depth of the random trees (default 5)
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "Board.h"
+#include "TronSim.h"
+#include "TunedWeights.h"
+
+namespace
+{
+typedef std::chrono::steady_clock Clock;
+
+struct Options
+{
+    unsigned games = 20;
+    uint32_t seed = 1;
+    unsigned depth = 5;
+};
+
+// Every this many ticks a position is kept for the tree check and the timing
+const unsigned SAMPLE_INTERVAL = 25;
+
+// Joint moves tried per tree node
+const unsigned TREE_BRANCHES = 3;
+
+// Random move vectors per sampled position in the timing
+const unsigned TIMING_MOVES = 2000;
+
+uint32_t nextRandom(uint32_t &state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+void randomMoves(uint32_t &rng, uint8_t moves[NUM_PLAYERS])
+{
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+        moves[i] = DIR_UP + nextRandom(rng) % 4;
+}
+
+/**
+ * @return 1 if the board differs from the state in any field, 0 otherwise
+ */
+unsigned compare(const Board &board, const TronState &state)
+{
+    static TronState seen;
+    board.toState(seen);
+    bool same = !memcmp(seen.grid, state.grid, sizeof(Grid)) && !memcmp(seen.x, state.x, sizeof(state.x)) &&
+                !memcmp(seen.y, state.y, sizeof(state.y)) && !memcmp(seen.heading, state.heading, sizeof(state.heading)) &&
+                seen.alive == state.alive && seen.hash == state.hash && board.hash() == computeHash(state);
+    return same ? 0 : 1;
+}
+
+/**
+ * Unmakes every tick on the board, comparing with the states it passed through
+ */
+unsigned unwind(Board &board, const std::vector<TronState> &history)
+{
+    unsigned mismatches = 0;
+    while (board.ply())
+    {
+        board.unmake();
+        mismatches += compare(board, history[board.ply()]);
+    }
+    return mismatches;
+}
+
+unsigned replayGame(uint32_t seed, std::vector<TronState> &samples)
+{
+    static Board board;
+    std::vector<TronState> history(1);
+    initTronState(history[0]);
+    board.init(history[0]);
+    unsigned mismatches = 0;
+    unsigned tick = 0;
+
+    SimPolicy policies[NUM_PLAYERS];
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+        policies[i] = weightedPolicy(TUNED_WEIGHTS);
+    SimOptions options;
+    options.seed = seed;
+    playGame(policies, options, [&](const TronState &state, const uint8_t moves[NUM_PLAYERS]) {
+        uint8_t died = board.make(moves);
+        mismatches += compare(board, state);
+        mismatches += died != (history.back().alive & ~state.alive) ? 1 : 0;
+        history.push_back(state);
+
+        if (board.ply() == BOARD_MAX_PLIES)
+        {
+            mismatches += unwind(board, history);
+            history.erase(history.begin(), history.end() - 1);
+            board.init(history[0]);
+        }
+        if (++tick % SAMPLE_INTERVAL == 0 && __builtin_popcount(state.alive) > 1)
+            samples.push_back(state);
+    });
+    mismatches += unwind(board, history);
+    return mismatches;
+}
+
+unsigned checkTree(Board &board, const TronState &state, unsigned depth, uint32_t &rng, uint64_t &nodes)
+{
+    if (!depth || __builtin_popcount(state.alive) < 2)
+        return 0;
+
+    unsigned mismatches = 0;
+    TronState child;
+    for (unsigned b = 0; b < TREE_BRANCHES; b++)
+    {
+        uint8_t moves[NUM_PLAYERS];
+        randomMoves(rng, moves);
+        memcpy(&child, &state, sizeof(TronState));
+        uint8_t expected = applyMoves(child, moves);
+        uint8_t died = board.make(moves);
+        nodes++;
+        mismatches += compare(board, child) + (died != expected ? 1 : 0);
+        mismatches += checkTree(board, child, depth - 1, rng, nodes);
+        board.unmake();
+        mismatches += compare(board, state);
+    }
+    return mismatches;
+}
+
+/**
+ * Average nanoseconds per tick of both ways to search a child
+ */
+void timeChildren(const std::vector<TronState> &samples, double &copyNs, double &boardNs)
+{
+    static Board board;
+    static TronState child;
+    uint32_t rng = 12345;
+    std::vector<uint8_t> moves(TIMING_MOVES * NUM_PLAYERS);
+    for (unsigned i = 0; i < TIMING_MOVES; i++)
+        randomMoves(rng, &moves[i * NUM_PLAYERS]);
+
+    double copySeconds = 0.0;
+    double boardSeconds = 0.0;
+    uint64_t sink = 0;
+    for (const TronState &state : samples)
+    {
+        Clock::time_point begin = Clock::now();
+        for (unsigned i = 0; i < TIMING_MOVES; i++)
+        {
+            memcpy(&child, &state, sizeof(TronState));
+            sink += applyMoves(child, &moves[i * NUM_PLAYERS]) + child.hash;
+        }
+        copySeconds += std::chrono::duration<double>(Clock::now() - begin).count();
+
+        board.init(state);
+        begin = Clock::now();
+        for (unsigned i = 0; i < TIMING_MOVES; i++)
+        {
+            sink += board.make(&moves[i * NUM_PLAYERS]) + board.hash();
+            board.unmake();
+        }
+        boardSeconds += std::chrono::duration<double>(Clock::now() - begin).count();
+    }
+    double count = samples.empty() ? 1.0 : (double)samples.size() * TIMING_MOVES;
+    copyNs = 1e9 * copySeconds / count;
+    boardNs = 1e9 * boardSeconds / count;
+    if (sink == 42)
+        printf(" "); // Keeps the loops from being optimized away
+}
+
+bool parseOptions(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        unsigned value = (unsigned)strtoul(argv[i + 1], nullptr, 0);
+        if (!strcmp(argv[i], "--games"))
+            options.games = value;
+        else if (!strcmp(argv[i], "--seed"))
+            options.seed = value;
+        else if (!strcmp(argv[i], "--depth"))
+            options.depth = value;
+        else
+        {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return false;
+        }
+    }
+    if (argc % 2 == 0)
+    {
+        fprintf(stderr, "Missing value for %s\n", argv[argc - 1]);
+        return false;
+    }
+    return options.depth <= BOARD_MAX_PLIES;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+        return 2;
+
+    std::vector<TronState> samples;
+    unsigned replayMismatches = 0;
+    for (unsigned game = 0; game < options.games; game++)
+        replayMismatches += replayGame(options.seed + game, samples);
+
+    static Board board;
+    unsigned treeMismatches = 0;
+    uint64_t nodes = 0;
+    uint32_t rng = options.seed | 1;
+    for (const TronState &state : samples)
+    {
+        board.init(state);
+        treeMismatches += checkTree(board, state, options.depth, rng, nodes);
+    }
+
+    double copyNs = 0.0;
+    double boardNs = 0.0;
+    timeChildren(samples, copyNs, boardNs);
+
+    printf("replay: %u games, %u mismatches\n", options.games, replayMismatches);
+    printf("tree:   %zu positions, %llu nodes, %u mismatches\n", samples.size(), (unsigned long long)nodes,
+           treeMismatches);
+    printf("child:  copy + applyMoves %.1f ns, make + unmake %.1f ns (Board %zu bytes, TronState %zu bytes)\n", copyNs,
+           boardNs, sizeof(Board), sizeof(TronState));
+    return replayMismatches || treeMismatches ? 1 : 0;
+}
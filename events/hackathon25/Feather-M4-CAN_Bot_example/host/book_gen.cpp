@@ -0,0 +1,295 @@
+// Feather-m4-can_bot_example/host/book_gen.cpp
+/**
+ * @file book_gen.cpp
+ * @brief Generator of the opening book in include/OpeningBookData.h
+ *
+ * Expands the game tree from the spawn points for player 1 (OpeningBook.h maps every other seat
+ * onto it). Our move in each book position is the deep search result, ties broken by the
+ * one-ply evaluation the firmware would otherwise run. Opponents branch over going straight and
+ * turning, but a line may only contain a limited number of opponent turns, which keeps the book
+ * on the likely positions. Lines where anybody dies end the book.
+ *
+ * The book stores moves, not the reasons for them, so it is only right for the search and the
+ * weights it was generated with. Rerun it after every change to TunedWeights.h, Evaluation.cpp
+ * or TronSearch.cpp; the output is deterministic, so an unchanged tree reproduces the file.
+ *
+ *   pio run -e native_book_gen && .pio/build/native_book_gen/program --ticks 12 --depth 6
+ *
+ * Options:
+ *   --ticks N        book positions are at most N - 1 ticks into the game (default 12)
+ *   --turns N        opponent turns per line (default 1)
+ *   --depth D        search depth per book position (default 6)
+ *   --threads N      worker threads (default: all hardware threads)
+ *   --output PATH    generated header (default include/OpeningBookData.h)
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Evaluation.h"
+#include "OpeningBook.h"
+#include "TronSearch.h"
+#include "TronSim.h"
+#include "TunedWeights.h"
+#include "WorkStealingPool.h"
+
+namespace
+{
+struct Options
+{
+    unsigned ticks = 12;
+    unsigned turns = 1;
+    unsigned depth = 6;
+    unsigned threads = 0;
+    std::string output = "include/OpeningBookData.h";
+};
+
+// Transposition table slots per worker thread
+const size_t TT_SLOTS = 1 << 16;
+const float SEARCH_WINDOW = 1.0e9f;
+
+struct Node
+{
+    TronState state;
+    uint32_t key;
+    uint8_t turns; // Opponent turns on the line so far
+    uint8_t move;  // Book move, DIR_NONE if every move loses immediately
+};
+
+struct Entry
+{
+    uint32_t key;
+    uint8_t move;
+};
+
+/**
+ * Search value of every root move, ties broken by the one-ply evaluation
+ */
+uint8_t bookMove(const TronState &state, uint8_t depth, TranspositionTable &tt)
+{
+    const uint8_t me = 0;
+    SearchContext context = {me, &tt, 0};
+    uint8_t replies[MAX_REPLIES][NUM_PLAYERS];
+    uint8_t replyCount = generateReplies(state, me, depth, replies);
+    uint8_t heads[NUM_PLAYERS][2];
+    headsOf(state, heads);
+    TronState child;
+
+    uint8_t best = DIR_NONE;
+    float bestValue = 0.0f;
+    float bestTieBreak = 0.0f;
+    for (uint8_t dir = DIR_UP; dir <= DIR_LEFT; dir++)
+    {
+        if (isReverse(dir, state.heading[me]) || state.grid[wrapX(state.x[me] + dx[dir - 1])][wrapY(state.y[me] + dy[dir - 1])])
+            continue;
+        float value = SEARCH_WINDOW;
+        for (uint8_t r = 0; r < replyCount; r++)
+        {
+            memcpy(&child, &state, sizeof(TronState));
+            replies[r][me] = dir;
+            applyMoves(child, replies[r]);
+            value = std::min(value, searchValue(context, child, depth - 1, -SEARCH_WINDOW, value));
+        }
+        float tieBreak = evaluateMove(state.grid, heads, me, state.heading[me], dir, TUNED_WEIGHTS);
+        if (best == DIR_NONE || value > bestValue || (value == bestValue && tieBreak > bestTieBreak))
+        {
+            best = dir;
+            bestValue = value;
+            bestTieBreak = tieBreak;
+        }
+    }
+    return best;
+}
+
+/**
+ * Children of a node: our book move against every opponent combination within the turn budget
+ */
+void expand(const Node &node, unsigned maxTurns, std::vector<Node> &children)
+{
+    uint8_t options[NUM_PLAYERS][3];
+    uint8_t cost[NUM_PLAYERS][3];
+    uint8_t optionCount[NUM_PLAYERS];
+    options[0][0] = node.move;
+    cost[0][0] = 0;
+    optionCount[0] = 1;
+    for (uint8_t i = 1; i < NUM_PLAYERS; i++)
+    {
+        optionCount[i] = 0;
+        uint8_t heading = node.state.heading[i];
+        for (uint8_t k = 0; k < 4; k++)
+        {
+            uint8_t dir = (heading - 1 + k) % 4 + 1; // Straight, right turn, (reverse), left turn
+            if (isReverse(dir, heading))
+                continue;
+            options[i][optionCount[i]] = dir;
+            cost[i][optionCount[i]++] = k ? 1 : 0;
+        }
+    }
+
+    uint8_t index[NUM_PLAYERS] = {0, 0, 0, 0};
+    for (;;)
+    {
+        uint8_t moves[NUM_PLAYERS];
+        unsigned turns = node.turns;
+        for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+        {
+            moves[i] = options[i][index[i]];
+            turns += cost[i][index[i]];
+        }
+        if (turns <= maxTurns)
+        {
+            Node child;
+            memcpy(&child.state, &node.state, sizeof(TronState));
+            if (!applyMoves(child.state, moves))
+            {
+                child.key = openingBookStep(node.key, moves);
+                child.turns = (uint8_t)turns;
+                child.move = DIR_NONE;
+                children.push_back(child);
+            }
+        }
+
+        uint8_t i = 0;
+        while (i < NUM_PLAYERS && ++index[i] >= optionCount[i])
+            index[i++] = 0;
+        if (i == NUM_PLAYERS)
+            break;
+    }
+}
+
+bool writeHeader(const Options &options, const std::vector<Entry> &entries)
+{
+    FILE *file = fopen(options.output.c_str(), "w");
+    if (!file)
+    {
+        fprintf(stderr, "Cannot write %s\n", options.output.c_str());
+        return false;
+    }
+    fprintf(file, "// Feather-m4-can_bot_example/include/OpeningBookData.h\n");
+    fprintf(file, "// Generated by host/book_gen.cpp - do not edit by hand, rerun the generator instead.\n");
+    fprintf(file, "// %u ticks, up to %u opponent turns per line, search depth %u: %u positions.\n\n", options.ticks,
+            options.turns, options.depth, (unsigned)entries.size());
+    fprintf(file, "#ifndef OPENING_BOOK_DATA_H\n#define OPENING_BOOK_DATA_H\n\n#include <stdint.h>\n\n");
+    fprintf(file, "constexpr uint8_t OPENING_BOOK_TICKS = %u;\n", options.ticks);
+    fprintf(file, "constexpr uint32_t OPENING_BOOK_SIZE = %u;\n\n", (unsigned)entries.size());
+
+    fprintf(file, "// Sorted position keys, see openingBookStep()\n");
+    fprintf(file, "constexpr uint32_t OPENING_BOOK_KEYS[OPENING_BOOK_SIZE] = {");
+    for (size_t i = 0; i < entries.size(); i++)
+        fprintf(file, "%s0x%08lXu,", i % 8 ? " " : "\n    ", (unsigned long)entries[i].key);
+    fprintf(file, "\n};\n\n");
+
+    fprintf(file, "// Move of each key, 2 bits each (direction - 1), four keys per byte\n");
+    fprintf(file, "constexpr uint8_t OPENING_BOOK_MOVES[(OPENING_BOOK_SIZE + 3) / 4] = {");
+    for (size_t i = 0; i < entries.size(); i += 4)
+    {
+        uint8_t packed = 0;
+        for (size_t k = i; k < i + 4 && k < entries.size(); k++)
+            packed |= (uint8_t)((entries[k].move - 1) << (2 * (k - i)));
+        fprintf(file, "%s0x%02X,", (i / 4) % 12 ? " " : "\n    ", packed);
+    }
+    fprintf(file, "\n};\n\n#endif\n");
+    fclose(file);
+    return true;
+}
+
+bool parseOptions(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        unsigned value = (unsigned)strtoul(argv[i + 1], nullptr, 0);
+        if (!strcmp(argv[i], "--ticks"))
+            options.ticks = value;
+        else if (!strcmp(argv[i], "--turns"))
+            options.turns = value;
+        else if (!strcmp(argv[i], "--depth"))
+            options.depth = value;
+        else if (!strcmp(argv[i], "--threads"))
+            options.threads = value;
+        else if (!strcmp(argv[i], "--output"))
+            options.output = argv[i + 1];
+        else
+        {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return false;
+        }
+    }
+    if (argc % 2 == 0)
+    {
+        fprintf(stderr, "Missing value for %s\n", argv[argc - 1]);
+        return false;
+    }
+    return options.ticks >= 1 && options.ticks <= 255 && options.depth >= 1 && options.depth <= SEARCH_MAX_DEPTH;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+        return 2;
+    if (!options.threads)
+        options.threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+
+    WorkStealingPool pool(options.threads);
+    std::vector<Entry> entries;
+    std::vector<Node> level(1);
+    initTronState(level[0].state);
+    level[0].key = OPENING_BOOK_ROOT;
+    level[0].turns = 0;
+    level[0].move = DIR_NONE;
+
+    printf("Opening book: %u ticks, %u opponent turns, depth %u, %u threads\n", options.ticks, options.turns,
+           options.depth, options.threads);
+    auto start = std::chrono::steady_clock::now();
+
+    for (unsigned tick = 0; tick < options.ticks && !level.empty(); tick++)
+    {
+        WorkStealingPool::TaskGroup group;
+        for (size_t n = 0; n < level.size(); n++)
+        {
+            pool.run(group, [&, n] {
+                thread_local std::unique_ptr<TranspositionTable::Slot[]> slots(new TranspositionTable::Slot[TT_SLOTS]);
+                thread_local TranspositionTable tt(slots.get(), TT_SLOTS);
+                level[n].move = bookMove(level[n].state, (uint8_t)options.depth, tt);
+            });
+        }
+        pool.wait(group);
+
+        std::vector<Node> next;
+        for (const Node &node : level)
+        {
+            if (node.move == DIR_NONE)
+                continue;
+            entries.push_back({node.key, node.move});
+            if (tick + 1 < options.ticks)
+                expand(node, options.turns, next);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        printf("tick %3u  %6u positions  %.1f s\n", tick, (unsigned)level.size(), elapsed.count());
+        level.swap(next);
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) { return a.key < b.key; });
+    for (size_t i = 1; i < entries.size(); i++)
+    {
+        if (entries[i].key == entries[i - 1].key)
+        {
+            fprintf(stderr, "Key collision 0x%08lX, the book would be ambiguous\n", (unsigned long)entries[i].key);
+            return 1;
+        }
+    }
+
+    if (!writeHeader(options, entries))
+        return 1;
+    printf("Wrote %u positions (%u bytes of flash) to %s\n", (unsigned)entries.size(),
+           (unsigned)(entries.size() * 4 + (entries.size() + 3) / 4), options.output.c_str());
+    return 0;
+}
@@ -0,0 +1,740 @@
+// Feather-m4-can_bot_example/host/bus_sim.cpp
+/**
+ * @file bus_sim.cpp
+ * @brief Firmware-in-the-loop simulation of the game bus for deadline analysis
+ *
+ * Runs the unchanged firmware sources (setup(), onReceive() and the game logic) as one of four
+ * players on the bit-level bus model from CanBus.h, together with a simulated game server and
+ * three simulated opponent bots. Every frame competes for the 500 kbit/s bus: the server's
+ * Die/GameState frames, four Move frames sharing ID 0x090, Join/Rename traffic between games
+ * and optional debug bursts of the opponents.
+ *
+ * For every tick in which the firmware player is alive, the time after the GameState was
+ * queued by the server is split into
+ *   rx       GameState waiting for and occupying the bus until the firmware receives it
+ *   compute  the firmware's onReceive() until it hands the Move frame to the controller
+ *   tx       Move waiting in the transmit FIFO, arbitration, error frames and the frame itself
+ * The server only accepts moves within 80 ms of the tick, so 80 ms - rx - tx is the time that
+ * is left for computation. The report shows its distribution and the worst case.
+ *
+ * Between callbacks the firmware's loop() body runs as long as the simulated idle time allows,
+ * so the hit rate of the speculative precomputation reflects the available idle time.
+ *
+ * Three copies of one deterministic bot on translated spawns would replay the same game, so
+ * every opponent is drawn per game from the tuned weights, jittered tuned weights and the
+ * basic strategies, and opens with a random number of random safe moves. --seed fixes both,
+ * so two builds compared with the same seed meet the same opponents and openings.
+ *
+ *   pio run -e native_bus_sim && .pio/build/native_bus_sim/program --games 20
+ *
+ * Options:
+ *   --games N          games to play (default 20)
+ *   --player P         slot of the firmware player, 1-4 (default 1)
+ *   --bitrate B        bus bitrate in bit/s (default 500000)
+ *   --tx-queue N       transmit FIFO depth of every bot (default 4)
+ *   --compute-us U     fixed firmware callback time per frame instead of the measured one
+ *   --slowdown F       factor from measured host time to M4 time, also for loop() (default 1)
+ *   --opponent-us U    opponents reply after a random delay of 0..U us (default 2000)
+ *   --debug-frames N   debug frames every opponent sends after each Move (default 0)
+ *   --debug-id ID      CAN ID of the debug frames (default 0x600)
+ *   --opening N        opponents open every game with up to N random safe moves (default 12)
+ *   --seed S           seed of opponent delays, policies and openings (default 1)
+ *   --verbose 1        print the firmware's serial output
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <initializer_list>
+#include <map>
+#include <vector>
+
+#include "Arduino.h"
+#include "CAN.h"
+#include "CanBus.h"
+#include "BasicStrategies.h"
+#include "CANHandler.h"
+#include "GameLogic.h"
+#include "Speculation.h"
+#include "TronSim.h"
+#include "TunedWeights.h"
+
+namespace
+{
+const uint64_t MS = 1000000ULL;
+const uint64_t TICK_NS = 100 * MS;
+const uint64_t MOVE_WINDOW_NS = 80 * MS;
+const uint64_t ACK_WINDOW_NS = 100 * MS;
+const uint16_t RENAME = 0x500;
+const uint16_t RENAME_FOLLOW = 0x510;
+
+struct Options
+{
+    unsigned games = 20;
+    unsigned player = 1;
+    uint32_t bitrate = 500000;
+    unsigned txQueue = 4;
+    double computeUs = -1.0;
+    double slowdown = 1.0;
+    unsigned opponentUs = 2000;
+    unsigned debugFrames = 0;
+    uint16_t debugId = 0x600;
+    unsigned opening = 12;
+    uint32_t seed = 1;
+    bool verbose = false;
+};
+
+uint32_t nextRandom(uint32_t &rng)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+enum OpponentKind
+{
+    OPPONENT_TUNED,
+    OPPONENT_JITTERED,
+    OPPONENT_FLOODFILL,
+    OPPONENT_OPENSPACE,
+    OPPONENT_RANDOM,
+    OPPONENT_KINDS
+};
+
+const char *const OPPONENT_NAMES[OPPONENT_KINDS] = {"tuned", "jittered", "floodfill", "openspace", "random"};
+
+CanFrame makeFrame(uint16_t id, std::initializer_list<uint8_t> bytes)
+{
+    CanFrame frame = {id, 0, {0}};
+    for (uint8_t byte : bytes)
+        frame.data[frame.dlc++] = byte;
+    return frame;
+}
+
+CanFrame joinFrame(uint32_t hardwareId)
+{
+    return makeFrame(Join, {(uint8_t)hardwareId, (uint8_t)(hardwareId >> 8), (uint8_t)(hardwareId >> 16),
+                            (uint8_t)(hardwareId >> 24)});
+}
+
+const char *frameName(uint16_t id)
+{
+    switch (id)
+    {
+    case Join: return "Join";
+    case Player: return "Player";
+    case Game: return "Game";
+    case GameAck: return "GameAck";
+    case GameState: return "GameState";
+    case Move: return "Move";
+    case Die: return "Die";
+    case GameFinish: return "GameFinish";
+    case Error: return "Error";
+    case RENAME: return "Rename";
+    case RENAME_FOLLOW: return "RenameFollow";
+    default: return "Debug";
+    }
+}
+
+/**
+ * Timing of one tick, seen from the firmware player
+ */
+struct TickTiming
+{
+    uint64_t queuedNs = 0;    // Server queued the GameState
+    uint64_t receivedNs = 0;  // Firmware received it
+    uint64_t moveReadyNs = 0; // Firmware handed its Move to the controller
+    uint64_t moveDoneNs = 0;  // Server received the Move
+};
+
+struct FrameStats
+{
+    unsigned count = 0;
+    unsigned minBits = ~0u;
+    unsigned maxBits = 0;
+    uint64_t totalBits = 0;
+    uint8_t maxDlc = 0;
+};
+
+class BusSimulation
+{
+public:
+    explicit BusSimulation(const Options &options)
+        : options_(options), bus_(options.bitrate), rng_(options.seed ? options.seed : 1),
+          opponentRng_(options.seed * 2654435761u | 1)
+    {
+        server_ = bus_.addNode("server", 16);
+        for (unsigned slot = 1; slot <= NUM_PLAYERS; slot++)
+        {
+            Bot bot;
+            bot.firmware = slot == options.player;
+            bot.hardwareId = bot.firmware ? HOST_HARDWARE_ID : 0xB0700000UL + slot;
+            char name[16];
+            snprintf(name, sizeof(name), bot.firmware ? "firmware" : "opponent%u", slot);
+            bot.node = bus_.addNode(name, options.txQueue);
+            bots_.push_back(bot);
+        }
+    }
+
+    void run()
+    {
+        Serial.enabled = options_.verbose;
+        tronshim::shimBus().transmit = [this](const CanFrame &frame) { return firmwareTransmit(frame); };
+
+        // Join in slot order, so the server assigns the slots as requested
+        for (unsigned slot = 0; slot < NUM_PLAYERS; slot++)
+        {
+            uint64_t joinNs = slot * MS;
+            if (bots_[slot].firmware)
+            {
+                beginCallback(joinNs);
+                setup();
+            }
+            else
+            {
+                bus_.transmit(bots_[slot].node, joinFrame(bots_[slot].hardwareId), joinNs);
+            }
+        }
+
+        while (gamesFinished_ < options_.games)
+        {
+            uint64_t start = bus_.nextStart();
+            if (start == UINT64_MAX && serverEventNs_ == UINT64_MAX)
+            {
+                fprintf(stderr, "Simulation stalled after %u games, nothing left to send\n", gamesFinished_);
+                break;
+            }
+            if (start < serverEventNs_)
+            {
+                CanDelivery delivery;
+                if (!bus_.step(delivery))
+                    continue;
+                // A tick due while the frame was on the bus happens first
+                while (serverEventNs_ < delivery.endNs)
+                    serverEvent();
+                dispatch(delivery);
+            }
+            else
+            {
+                serverEvent();
+            }
+        }
+    }
+
+    void report() const
+    {
+        printf("Bus: %u bit/s, %u games, %u ticks, firmware as player %u, TX FIFO depth %u\n", options_.bitrate,
+               gamesFinished_, ticks_, options_.player, options_.txQueue);
+        unsigned opponentPoints = 0;
+        for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+            opponentPoints += i + 1u == options_.player ? 0 : pointsTotal_[i];
+        unsigned games = gamesFinished_ ? gamesFinished_ : 1;
+        printf("Points per game: firmware (%s strategy) %.2f, opponents %.2f on average\n", strategyName(),
+               (double)pointsTotal_[options_.player - 1] / games, opponentPoints / 3.0 / games);
+        printf("Opponents (seed %u, openings up to %u moves):", (unsigned)options_.seed, options_.opening);
+        for (int kind = 0; kind < OPPONENT_KINDS; kind++)
+            printf(" %u %s", opponentKinds_[kind], OPPONENT_NAMES[kind]);
+        printf("\n");
+
+        printf("\n%-13s %5s %4s %8s %10s %10s %10s %11s\n", "frame", "ID", "DLC", "count", "min bits", "avg bits",
+               "max bits", "worst case");
+        for (const auto &entry : frames_)
+        {
+            const FrameStats &s = entry.second;
+            printf("%-13s 0x%03X %4u %8u %10u %10.1f %10u %11u\n", frameName(entry.first), entry.first, s.maxDlc,
+                   s.count, s.minBits, (double)s.totalBits / s.count, s.maxBits, canWorstCaseFrameBits(s.maxDlc));
+        }
+
+        printf("\n%-11s %8s %9s %10s %10s %9s %7s %8s\n", "node", "sent", "lost arb", "bit errors", "FIFO full",
+               "max FIFO", "max TEC", "bus-offs");
+        for (int i = 0; i < bus_.nodeCount(); i++)
+        {
+            const CanNodeStats &s = bus_.stats(i);
+            printf("%-11s %8u %9u %10u %10u %9u %7u %8u\n", s.name.c_str(), s.sent, s.lostArbitration, s.bitErrors,
+                   s.queueFull, s.maxQueued, s.maxTec, s.busOffs);
+        }
+
+        double elapsed = (double)tronshim::nowNs;
+        printf("\nBus load: %.2f%% average, %.2f%% in the busiest tick, %u error frames\n",
+               elapsed > 0 ? 100.0 * bus_.busyNs() / elapsed : 0.0, 100.0 * peakTickBusyNs_ / TICK_NS,
+               bus_.errorFrames());
+
+        std::vector<double> rx, compute, tx, slack;
+        unsigned late = 0;
+        for (const TickTiming &t : timings_)
+        {
+            rx.push_back((t.receivedNs - t.queuedNs) / 1000.0);
+            compute.push_back((t.moveReadyNs - t.receivedNs) / 1000.0);
+            tx.push_back((t.moveDoneNs - t.moveReadyNs) / 1000.0);
+            slack.push_back(((double)MOVE_WINDOW_NS - (double)(t.moveDoneNs - t.queuedNs)) / 1000.0);
+            late += t.moveDoneNs - t.queuedNs > MOVE_WINDOW_NS;
+        }
+        if (timings_.empty())
+        {
+            printf("\nThe firmware player sent no moves.\n");
+            return;
+        }
+
+        printf("\nMove window of the firmware player over %u ticks [us]:\n", (unsigned)timings_.size());
+        printf("%-10s %10s %10s %10s %10s %10s\n", "", "min", "p50", "p99", "p99.9", "max");
+        printRow("rx", rx);
+        printRow("compute", compute);
+        printRow("tx", tx);
+        printRow("slack", slack);
+
+        double worstRx = *std::max_element(rx.begin(), rx.end());
+        double worstTx = *std::max_element(tx.begin(), tx.end());
+        printf("\nLeft for computation: 80 ms - %.1f us (worst rx) - %.1f us (worst tx) = %.3f ms\n", worstRx, worstTx,
+               (MOVE_WINDOW_NS / 1000.0 - worstRx - worstTx) / 1000.0);
+        printf("Late moves (received after 80 ms): %u, ignored by the TX FIFO: %u\n", late, movesRejected_);
+
+        const SpeculationStats &sp = speculation_;
+        uint32_t lookups = sp.hits + sp.notReady + sp.misses + sp.skipped;
+        printf("Speculation: %u/%u hits (%.1f%%), %u not ready, %u misses, %u skipped, %u/%u candidates evaluated\n",
+               sp.hits, lookups, lookups ? 100.0 * sp.hits / lookups : 0.0, sp.notReady, sp.misses, sp.skipped,
+               sp.evaluated, sp.prepared);
+    }
+
+private:
+    struct Bot
+    {
+        bool firmware;
+        uint32_t hardwareId;
+        int node;
+        bool joined = false;
+        bool acked = false;
+    };
+
+    enum ServerPhase
+    {
+        WAIT_JOIN,
+        WAIT_ACK,
+        RUNNING
+    };
+
+    static void printRow(const char *name, std::vector<double> values)
+    {
+        std::sort(values.begin(), values.end());
+        auto at = [&](double q) { return values[std::min(values.size() - 1, (size_t)(q * values.size()))]; };
+        printf("%-10s %10.1f %10.1f %10.1f %10.1f %10.1f\n", name, values.front(), at(0.5), at(0.99), at(0.999),
+               values.back());
+    }
+
+    uint64_t opponentDelay()
+    {
+        return options_.opponentUs ? (nextRandom(rng_) % (options_.opponentUs + 1)) * 1000ULL : 0;
+    }
+
+    /**
+     * Draws the policy and the opening length of every opponent for the next game
+     */
+    void drawOpponents()
+    {
+        for (unsigned slot = 0; slot < NUM_PLAYERS; slot++)
+        {
+            if (bots_[slot].firmware)
+                continue;
+            OpponentKind kind = (OpponentKind)(nextRandom(opponentRng_) % OPPONENT_KINDS);
+            opponentKinds_[kind]++;
+            switch (kind)
+            {
+            case OPPONENT_TUNED:
+                opponentPolicies_[slot] = weightedPolicy(TUNED_WEIGHTS);
+                break;
+            case OPPONENT_JITTERED:
+            {
+                // Up to +-50% on the weights that rank free moves
+                EvalWeights weights = TUNED_WEIGHTS;
+                for (float *weight : {&weights.distance, &weights.wall_bonus, &weights.straight_bonus})
+                    *weight *= 0.5f + (nextRandom(opponentRng_) % 1001) / 1000.0f;
+                opponentPolicies_[slot] = weightedPolicy(weights);
+                break;
+            }
+            case OPPONENT_FLOODFILL:
+                opponentPolicies_[slot] = strategyPolicy<FloodFillStrategy>();
+                break;
+            case OPPONENT_OPENSPACE:
+                opponentPolicies_[slot] = strategyPolicy<OpenSpaceStrategy>();
+                break;
+            default:
+                opponentPolicies_[slot] = strategyPolicy<RandomStrategy>();
+                break;
+            }
+            openingTicks_[slot] = nextRandom(opponentRng_) % (options_.opening + 1);
+        }
+    }
+
+    /**
+     * Random move of an opponent that does not crash at once, the heading if there is none
+     */
+    uint8_t openingMove(unsigned slot)
+    {
+        uint8_t safe[4];
+        uint8_t count = 0;
+        for (uint8_t dir = DIR_UP; dir <= DIR_LEFT; dir++)
+        {
+            if (!isReverse(dir, game_.heading[slot]) &&
+                !game_.grid[wrapX(game_.x[slot] + dx[dir - 1])][wrapY(game_.y[slot] + dy[dir - 1])])
+                safe[count++] = dir;
+        }
+        return count ? safe[nextRandom(opponentRng_) % count] : game_.heading[slot];
+    }
+
+    // The firmware runs with the bus time of the frame that triggered it
+    void beginCallback(uint64_t nowNs)
+    {
+        tronshim::nowNs = nowNs;
+        callbackStart_ = std::chrono::steady_clock::now();
+    }
+
+    // Simulated M4 time since beginCallback()
+    uint64_t elapsedNs() const
+    {
+        if (options_.computeUs >= 0.0)
+            return (uint64_t)(options_.computeUs * 1000.0);
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - callbackStart_;
+        return (uint64_t)(elapsed.count() * options_.slowdown);
+    }
+
+    /**
+     * Runs the loop() body of the firmware until the bus time reaches untilNs. A step only
+     * starts if the previous one would have fit, since the callback would preempt it.
+     */
+    void runIdle(uint64_t untilNs)
+    {
+        uint64_t nowNs = firmwareFreeNs_;
+        while (nowNs + lastStepNs_ <= untilNs)
+        {
+            tronshim::nowNs = nowNs;
+            auto start = std::chrono::steady_clock::now();
+            bool worked = speculateNextMove();
+            std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            if (!worked)
+                break;
+            lastStepNs_ = (uint64_t)(elapsed.count() * options_.slowdown);
+            nowNs += lastStepNs_;
+        }
+    }
+
+    void addSpeculationStats()
+    {
+        const SpeculationStats &s = speculationStats();
+        speculation_.hits += s.hits;
+        speculation_.notReady += s.notReady;
+        speculation_.misses += s.misses;
+        speculation_.skipped += s.skipped;
+        speculation_.evaluated += s.evaluated;
+        speculation_.prepared += s.prepared;
+    }
+
+    bool firmwareTransmit(const CanFrame &frame)
+    {
+        uint64_t readyNs = tronshim::nowNs + elapsedNs();
+        bool accepted = bus_.transmit(bots_[options_.player - 1].node, frame, readyNs);
+        if (frame.id == Move)
+        {
+            // Only the first move per tick counts, later ones just correct it
+            if (accepted && tick_.receivedNs && !tick_.moveReadyNs)
+            {
+                tick_.moveReadyNs = readyNs;
+                inFlight_.push_back(tick_);
+            }
+            movesRejected_ += !accepted;
+        }
+        return accepted;
+    }
+
+    void dispatch(const CanDelivery &delivery)
+    {
+        FrameStats &stats = frames_[delivery.frame.id];
+        stats.count++;
+        stats.minBits = std::min(stats.minBits, delivery.bits);
+        stats.maxBits = std::max(stats.maxBits, delivery.bits);
+        stats.totalBits += delivery.bits;
+        stats.maxDlc = std::max(stats.maxDlc, delivery.frame.dlc);
+
+        if (delivery.sender != server_)
+            serverReceive(delivery);
+        for (unsigned slot = 0; slot < NUM_PLAYERS; slot++)
+        {
+            if (bots_[slot].node == delivery.sender)
+                continue;
+            if (bots_[slot].firmware)
+            {
+                if (delivery.frame.id == GameState && game_.alive & (1 << slot))
+                    tick_.receivedNs = delivery.endNs;
+                runIdle(delivery.endNs);
+                if (delivery.frame.id == GameFinish)
+                    addSpeculationStats();
+                beginCallback(delivery.endNs);
+                tronshim::shimBus().deliver(delivery.frame);
+                firmwareFreeNs_ = delivery.endNs + elapsedNs();
+            }
+            else
+            {
+                opponentReceive(slot, delivery);
+            }
+        }
+    }
+
+    void opponentReceive(unsigned slot, const CanDelivery &delivery)
+    {
+        const CanFrame &frame = delivery.frame;
+        Bot &bot = bots_[slot];
+        uint8_t id = slot + 1;
+        switch (frame.id)
+        {
+        case Player:
+            if (frame.data[0] == (uint8_t)bot.hardwareId && frame.data[1] == (uint8_t)(bot.hardwareId >> 8))
+            {
+                bus_.transmit(bot.node, makeFrame(RENAME, {id, 9, 'o', 'p', 'p', 'o', 'n', 'e'}), delivery.endNs);
+                bus_.transmit(bot.node, makeFrame(RENAME_FOLLOW, {id, 'n', 't', '0', (uint8_t)('0' + id)}),
+                              delivery.endNs);
+            }
+            break;
+        case Game:
+            bus_.transmit(bot.node, makeFrame(GameAck, {id}), delivery.endNs + opponentDelay());
+            break;
+        case GameState:
+            if (game_.alive & (1 << slot))
+            {
+                uint64_t readyNs = delivery.endNs + opponentDelay();
+                uint8_t direction =
+                    gameTicks_ < openingTicks_[slot] ? openingMove(slot) : opponentPolicies_[slot](game_, slot);
+                bus_.transmit(bot.node, makeFrame(Move, {id, direction}), readyNs);
+                for (unsigned i = 0; i < options_.debugFrames; i++)
+                {
+                    bus_.transmit(bot.node,
+                                  makeFrame(options_.debugId, {id, (uint8_t)i, game_.x[slot], game_.y[slot], direction,
+                                                               (uint8_t)ticks_, (uint8_t)(ticks_ >> 8), 0xA5}),
+                                  readyNs);
+                }
+            }
+            break;
+        case GameFinish:
+            bus_.transmit(bot.node, joinFrame(bot.hardwareId), delivery.endNs + opponentDelay());
+            break;
+        default:
+            break;
+        }
+    }
+
+    void serverReceive(const CanDelivery &delivery)
+    {
+        const CanFrame &frame = delivery.frame;
+        switch (frame.id)
+        {
+        case Join:
+        {
+            uint32_t hardwareId = frame.data[0] | frame.data[1] << 8 | frame.data[2] << 16 | (uint32_t)frame.data[3] << 24;
+            for (unsigned slot = 0; slot < NUM_PLAYERS; slot++)
+            {
+                if (bots_[slot].hardwareId != hardwareId)
+                    continue;
+                bots_[slot].joined = true;
+                bus_.transmit(server_,
+                              makeFrame(Player, {frame.data[0], frame.data[1], frame.data[2], frame.data[3],
+                                                 (uint8_t)(slot + 1)}),
+                              delivery.endNs);
+            }
+            if (phase_ == WAIT_JOIN && std::all_of(bots_.begin(), bots_.end(), [](const Bot &b) { return b.joined; }))
+                startGame(delivery.endNs);
+            break;
+        }
+        case GameAck:
+            if (phase_ == WAIT_ACK && frame.data[0] >= 1 && frame.data[0] <= NUM_PLAYERS)
+                bots_[frame.data[0] - 1].acked = true;
+            break;
+        case Move:
+            if (phase_ == RUNNING && frame.data[0] >= 1 && frame.data[0] <= NUM_PLAYERS)
+            {
+                uint8_t slot = frame.data[0] - 1;
+                moves_[slot] = frame.data[1];
+                if (slot == options_.player - 1 && !inFlight_.empty() && inFlight_.front().moveReadyNs <= delivery.queuedNs)
+                {
+                    inFlight_.front().moveDoneNs = delivery.endNs;
+                    timings_.push_back(inFlight_.front());
+                    inFlight_.pop_front();
+                }
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    void startGame(uint64_t nowNs)
+    {
+        for (Bot &bot : bots_)
+            bot.acked = false;
+        bus_.transmit(server_, makeFrame(Game, {1, 2, 3, 4}), nowNs);
+        phase_ = WAIT_ACK;
+        serverEventNs_ = nowNs + ACK_WINDOW_NS;
+    }
+
+    void serverEvent()
+    {
+        uint64_t nowNs = serverEventNs_;
+        if (phase_ == WAIT_ACK)
+        {
+            if (!std::all_of(bots_.begin(), bots_.end(), [](const Bot &b) { return b.acked; }))
+            {
+                startGame(nowNs); // Canceled, invite again
+                return;
+            }
+            initTronState(game_);
+            drawOpponents();
+            memset(moves_, DIR_NONE, sizeof(moves_));
+            memset(points_, 0, sizeof(points_));
+            deadCount_ = 0;
+            gameTicks_ = 0;
+            phase_ = RUNNING;
+        }
+        else
+        {
+            uint8_t died = applyMoves(game_, moves_);
+            memset(moves_, DIR_NONE, sizeof(moves_));
+            for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+            {
+                if (died & (1 << i))
+                {
+                    points_[i] = deadCount_ + 1;
+                    bus_.transmit(server_, makeFrame(Die, {(uint8_t)(i + 1)}), nowNs);
+                }
+            }
+            deadCount_ += __builtin_popcount(died);
+
+            if (__builtin_popcount(game_.alive) <= 1 || gameTicks_ >= SimOptions().maxTicks)
+            {
+                CanFrame finish = {GameFinish, 8, {0}};
+                for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+                {
+                    finish.data[2 * i] = i + 1;
+                    finish.data[2 * i + 1] = game_.alive & (1 << i) ? deadCount_ + 1 : points_[i];
+                    pointsTotal_[i] += finish.data[2 * i + 1];
+                }
+                bus_.transmit(server_, finish, nowNs);
+                for (Bot &bot : bots_)
+                    bot.joined = false;
+                phase_ = WAIT_JOIN;
+                serverEventNs_ = UINT64_MAX;
+                gamesFinished_++;
+                tick_ = TickTiming();
+                return;
+            }
+        }
+
+        CanFrame state = {GameState, 8, {0}};
+        for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+        {
+            state.data[2 * i] = game_.x[i];
+            state.data[2 * i + 1] = game_.y[i];
+        }
+        bus_.transmit(server_, state, nowNs);
+
+        uint64_t busy = bus_.busyNs();
+        if (ticks_)
+            peakTickBusyNs_ = std::max(peakTickBusyNs_, busy - lastTickBusyNs_);
+        lastTickBusyNs_ = busy;
+
+        tick_ = TickTiming();
+        tick_.queuedNs = nowNs;
+        ticks_++;
+        gameTicks_++;
+        serverEventNs_ = nowNs + TICK_NS;
+    }
+
+    Options options_;
+    CanBus bus_;
+    uint32_t rng_;         // Bus timing of the opponents
+    uint32_t opponentRng_; // Opponent policies and openings, independent of the firmware's timing
+    int server_;
+    std::vector<Bot> bots_;
+    SimPolicy opponentPolicies_[NUM_PLAYERS];
+    unsigned openingTicks_[NUM_PLAYERS] = {0, 0, 0, 0};
+    unsigned opponentKinds_[OPPONENT_KINDS] = {0, 0, 0, 0, 0};
+
+    ServerPhase phase_ = WAIT_JOIN;
+    uint64_t serverEventNs_ = UINT64_MAX;
+    TronState game_;
+    uint8_t moves_[NUM_PLAYERS];
+    uint8_t points_[NUM_PLAYERS];
+    unsigned pointsTotal_[NUM_PLAYERS] = {0, 0, 0, 0}; // Over all games, for the strength comparison
+    uint8_t deadCount_ = 0;
+    unsigned gameTicks_ = 0;
+    unsigned gamesFinished_ = 0;
+
+    std::chrono::steady_clock::time_point callbackStart_;
+    uint64_t firmwareFreeNs_ = 0; // End of the last callback
+    uint64_t lastStepNs_ = 0;     // Duration of the last loop() step
+    SpeculationStats speculation_ = {0, 0, 0, 0, 0, 0};
+    TickTiming tick_;
+    std::deque<TickTiming> inFlight_; // Moves of the firmware not yet received by the server
+    std::vector<TickTiming> timings_;
+    std::map<uint16_t, FrameStats> frames_;
+    unsigned ticks_ = 0;
+    unsigned movesRejected_ = 0;
+    uint64_t lastTickBusyNs_ = 0;
+    uint64_t peakTickBusyNs_ = 0;
+};
+
+bool parseOptions(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const char *value = argv[i + 1];
+        if (!strcmp(argv[i], "--games"))
+            options.games = (unsigned)strtoul(value, nullptr, 0);
+        else if (!strcmp(argv[i], "--player"))
+            options.player = (unsigned)strtoul(value, nullptr, 0);
+        else if (!strcmp(argv[i], "--bitrate"))
+            options.bitrate = (uint32_t)strtoul(value, nullptr, 0);
+        else if (!strcmp(argv[i], "--tx-queue"))
+            options.txQueue = (unsigned)strtoul(value, nullptr, 0);
+        else if (!strcmp(argv[i], "--compute-us"))
+            options.computeUs = strtod(value, nullptr);
+        else if (!strcmp(argv[i], "--slowdown"))
+            options.slowdown = strtod(value, nullptr);
+        else if (!strcmp(argv[i], "--opponent-us"))
+            options.opponentUs = (unsigned)strtoul(value, nullptr, 0);
+        else if (!strcmp(argv[i], "--debug-frames"))
+            options.debugFrames = (unsigned)strtoul(value, nullptr, 0);
+        else if (!strcmp(argv[i], "--debug-id"))
+            options.debugId = (uint16_t)strtoul(value, nullptr, 0);
+        else if (!strcmp(argv[i], "--opening"))
+            options.opening = (unsigned)strtoul(value, nullptr, 0);
+        else if (!strcmp(argv[i], "--seed"))
+            options.seed = (uint32_t)strtoul(value, nullptr, 0);
+        else if (!strcmp(argv[i], "--verbose"))
+            options.verbose = strtoul(value, nullptr, 0) != 0;
+        else
+        {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return false;
+        }
+    }
+    if (argc % 2 == 0)
+    {
+        fprintf(stderr, "Missing value for %s\n", argv[argc - 1]);
+        return false;
+    }
+    return options.games > 0 && options.player >= 1 && options.player <= NUM_PLAYERS && options.bitrate > 0 &&
+           options.debugId < 0x800;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+        return 2;
+
+    BusSimulation simulation(options);
+    simulation.run();
+    simulation.report();
+    return 0;
+}
@@ -0,0 +1,319 @@
+// Feather-m4-can_bot_example/host/endgame_check.cpp
+/**
+ * @file endgame_check.cpp
+ * @brief Checks the endgame solver against brute force and measures it in self-play
+ *
+ * Two parts:
+ * - Random pockets: connected regions of 1 to --max-brute cells carved into a full grid. The
+ *   solver's path length must equal an exhaustive search, its first move must lead into a path
+ *   of that length, and the same pocket shifted elsewhere on the torus must be a cache hit
+ *   with the same answer.
+ * - Self-play: games of the one-ply evaluation. Whenever a player is sealed in a pocket, the
+ *   solver's path length is compared with the ticks chooseMove() survives in the same pocket.
+ *   Solve times and cache hits are reported as well.
+ *
+ *   pio run -e native_endgame_check && .pio/build/native_endgame_check/program --games 200
+ *
+ * Options:
+ *   --pockets N      random pockets (default 2000)
+ *   --max-brute N    largest random pocket, brute force is exponential (default 16)
+ *   --games N        self-play games (default 200)
+ *   --seed S         seed of pockets and games (default 1)
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "EndgameSolver.h"
+#include "Evaluation.h"
+#include "TronSim.h"
+#include "TunedWeights.h"
+
+namespace
+{
+struct Options
+{
+    unsigned pockets = 2000;
+    unsigned maxBrute = 16;
+    unsigned games = 200;
+    uint32_t seed = 1;
+};
+
+uint32_t nextRandom(uint32_t &rng)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+/**
+ * Longest path from a head through free cells, trying everything
+ */
+uint8_t bruteForce(Grid &grid, uint8_t x, uint8_t y)
+{
+    uint8_t best = 0;
+    for (uint8_t dir = 0; dir < 4; dir++)
+    {
+        uint8_t nx = wrapX(x + dx[dir]);
+        uint8_t ny = wrapY(y + dy[dir]);
+        if (grid[nx][ny])
+            continue;
+        grid[nx][ny] = 1;
+        uint8_t length = 1 + bruteForce(grid, nx, ny);
+        grid[nx][ny] = 0;
+        best = length > best ? length : best;
+    }
+    return best;
+}
+
+/**
+ * Fills the grid with an opponent's trace and carves a connected pocket of the given size
+ * next to our head (player 0)
+ */
+void carvePocket(uint32_t &rng, Grid &grid, uint8_t heads[NUM_PLAYERS][2], uint8_t cells)
+{
+    memset(grid, 2, sizeof(Grid)); // The head came from any side, all of them are walls
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+        heads[i][0] = heads[i][1] = NO_POSITION;
+    uint8_t hx = nextRandom(rng) % GRID_WIDTH;
+    uint8_t hy = nextRandom(rng) % GRID_HEIGHT;
+    heads[0][0] = hx;
+    heads[0][1] = hy;
+    grid[hx][hy] = 1;
+
+    std::vector<std::pair<uint8_t, uint8_t>> carved;
+    uint8_t dir = nextRandom(rng) % 4;
+    carved.push_back({wrapX(hx + dx[dir]), wrapY(hy + dy[dir])});
+    grid[carved[0].first][carved[0].second] = 0;
+    while (carved.size() < cells)
+    {
+        const auto &from = carved[nextRandom(rng) % carved.size()];
+        dir = nextRandom(rng) % 4;
+        uint8_t nx = wrapX(from.first + dx[dir]);
+        uint8_t ny = wrapY(from.second + dy[dir]);
+        if (grid[nx][ny] != 2)
+            continue;
+        grid[nx][ny] = 0;
+        carved.push_back({nx, ny});
+    }
+}
+
+/**
+ * Ticks that chooseMove() survives alone in the pocket
+ */
+unsigned greedyTicks(const Grid &start, const uint8_t startHeads[NUM_PLAYERS][2], uint8_t me, uint8_t heading)
+{
+    static Grid grid;
+    memcpy(grid, start, sizeof(Grid));
+    uint8_t heads[NUM_PLAYERS][2];
+    memcpy(heads, startHeads, sizeof(heads));
+    unsigned ticks = 0;
+    while (true)
+    {
+        uint8_t dir = chooseMove(grid, heads, me, heading, TUNED_WEIGHTS);
+        uint8_t nx = wrapX(heads[me][0] + dx[dir - 1]);
+        uint8_t ny = wrapY(heads[me][1] + dy[dir - 1]);
+        if (isReverse(dir, heading) || grid[nx][ny])
+            return ticks;
+        grid[nx][ny] = me + 1;
+        heads[me][0] = nx;
+        heads[me][1] = ny;
+        heading = dir;
+        ticks++;
+    }
+}
+
+void shiftGrid(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], uint8_t sx, uint8_t sy, Grid &shifted,
+               uint8_t shiftedHeads[NUM_PLAYERS][2])
+{
+    for (uint8_t x = 0; x < GRID_WIDTH; x++)
+    {
+        for (uint8_t y = 0; y < GRID_HEIGHT; y++)
+            shifted[wrapX(x + sx)][wrapY(y + sy)] = grid[x][y];
+    }
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+    {
+        bool alive = heads[i][0] != NO_POSITION;
+        shiftedHeads[i][0] = alive ? wrapX(heads[i][0] + sx) : NO_POSITION;
+        shiftedHeads[i][1] = alive ? wrapY(heads[i][1] + sy) : NO_POSITION;
+    }
+}
+
+unsigned checkPockets(const Options &options)
+{
+    uint32_t rng = options.seed ? options.seed : 1;
+    unsigned failures = 0;
+    unsigned hits = 0;
+    unsigned shorter = 0;
+    unsigned long lost = 0;
+    static Grid grid;
+    static Grid shifted;
+    uint8_t heads[NUM_PLAYERS][2];
+    uint8_t shiftedHeads[NUM_PLAYERS][2];
+    endgameClearCache();
+    for (unsigned n = 0; n < options.pockets; n++)
+    {
+        uint8_t cells = 1 + n % options.maxBrute;
+        carvePocket(rng, grid, heads, cells);
+
+        EndgameResult result;
+        if (!solveEndgame(grid, heads, 0, result) || !result.exact)
+        {
+            printf("Pocket %u (%u cells): not solved\n", n, cells);
+            failures++;
+            continue;
+        }
+        uint8_t expected = bruteForce(grid, heads[0][0], heads[0][1]);
+
+        // The first move must lead into a path of the reported length
+        uint8_t nx = wrapX(heads[0][0] + dx[result.direction - 1]);
+        uint8_t ny = wrapY(heads[0][1] + dy[result.direction - 1]);
+        uint8_t followed = 0;
+        if (!grid[nx][ny])
+        {
+            grid[nx][ny] = 1;
+            followed = 1 + bruteForce(grid, nx, ny);
+            grid[nx][ny] = 0;
+        }
+
+        EndgameResult again;
+        shiftGrid(grid, heads, nextRandom(rng) % GRID_WIDTH, nextRandom(rng) % GRID_HEIGHT, shifted, shiftedHeads);
+        bool shiftedOk = solveEndgame(shifted, shiftedHeads, 0, again) && again.length == result.length &&
+                         again.direction == result.direction;
+        hits += again.cached;
+
+        // A heading we could have arrived with: the cell behind the head is a wall
+        uint8_t heading = DIR_UP;
+        for (uint8_t d = DIR_UP; d <= DIR_LEFT; d++)
+        {
+            if (grid[wrapX(heads[0][0] - dx[d - 1])][wrapY(heads[0][1] - dy[d - 1])])
+                heading = d;
+        }
+        unsigned greedy = greedyTicks(grid, heads, 0, heading);
+        shorter += greedy < result.length;
+        lost += result.length - greedy;
+
+        if (result.length != expected || followed != expected || result.cells != cells || !shiftedOk)
+        {
+            printf("Pocket %u (%u cells): solver %u, brute force %u, after first move %u, shifted %s\n", n, cells,
+                   result.length, expected, followed, shiftedOk ? "ok" : "differs");
+            failures++;
+        }
+    }
+    printf("Random pockets: %u of up to %u cells, %u failures, %u of the shifted copies were cache hits\n",
+           options.pockets, options.maxBrute, failures, hits);
+    printf("chooseMove() is shorter in %u of them, by %.2f ticks on average\n", shorter,
+           (double)lost / options.pockets);
+    return failures;
+}
+
+void checkSelfPlay(const Options &options)
+{
+    SimPolicy policies[NUM_PLAYERS];
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+        policies[i] = weightedPolicy(TUNED_WEIGHTS);
+
+    endgameClearCache();
+    endgameResetStats();
+    unsigned positions = 0;
+    unsigned improved = 0;
+    unsigned worse = 0;
+    unsigned long solverTicks = 0;
+    unsigned long greedyTotal = 0;
+    double solveMicros = 0.0;
+    double hitMicros = 0.0;
+    unsigned solves = 0;
+    unsigned lookups = 0;
+    for (unsigned g = 0; g < options.games; g++)
+    {
+        SimOptions sim;
+        sim.seed = options.seed + g;
+        playGame(policies, sim, [&](const TronState &state, const uint8_t *) {
+            uint8_t heads[NUM_PLAYERS][2];
+            headsOf(state, heads);
+            for (uint8_t me = 0; me < NUM_PLAYERS; me++)
+            {
+                if (!(state.alive & (1 << me)))
+                    continue;
+                EndgameResult result;
+                auto start = std::chrono::steady_clock::now();
+                bool sealed = solveEndgame(state.grid, heads, me, result);
+                std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+                if (!sealed)
+                    continue;
+                if (result.cached)
+                {
+                    hitMicros += elapsed.count();
+                    lookups++;
+                }
+                else
+                {
+                    solveMicros += elapsed.count();
+                    solves++;
+                }
+                if (!result.exact)
+                    continue;
+
+                unsigned greedy = greedyTicks(state.grid, heads, me, state.heading[me]);
+                positions++;
+                solverTicks += result.length;
+                greedyTotal += greedy;
+                improved += result.length > greedy;
+                worse += result.length < greedy;
+            }
+        });
+    }
+
+    const EndgameStats &stats = endgameStats();
+    printf("Self-play: %u games, %lu sealed decisions, %lu cache hits, %lu solved, %lu stopped by the node limit\n",
+           options.games, (unsigned long)stats.sealed, (unsigned long)stats.hits, (unsigned long)stats.solved,
+           (unsigned long)stats.aborted);
+    printf("Exact pockets: solver %.2f ticks, chooseMove %.2f ticks on average; longer in %u of %u, shorter in %u\n",
+           positions ? (double)solverTicks / positions : 0.0, positions ? (double)greedyTotal / positions : 0.0,
+           improved, positions, worse);
+    printf("Time: %.1f us per solve (%.0f nodes), %.2f us per cache hit\n", solves ? solveMicros / solves : 0.0,
+           solves ? (double)stats.nodes / solves : 0.0, lookups ? hitMicros / lookups : 0.0);
+}
+
+bool parseOptions(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        unsigned value = (unsigned)strtoul(argv[i + 1], nullptr, 0);
+        if (!strcmp(argv[i], "--pockets"))
+            options.pockets = value;
+        else if (!strcmp(argv[i], "--max-brute"))
+            options.maxBrute = value;
+        else if (!strcmp(argv[i], "--games"))
+            options.games = value;
+        else if (!strcmp(argv[i], "--seed"))
+            options.seed = value;
+        else
+        {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return false;
+        }
+    }
+    if (argc % 2 == 0)
+    {
+        fprintf(stderr, "Missing value for %s\n", argv[argc - 1]);
+        return false;
+    }
+    return options.maxBrute >= 1 && options.maxBrute <= ENDGAME_MAX_CELLS;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+        return 2;
+
+    unsigned failures = checkPockets(options);
+    checkSelfPlay(options);
+    return failures ? 1 : 0;
+}
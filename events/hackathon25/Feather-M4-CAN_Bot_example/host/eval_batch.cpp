@@ -0,0 +1,215 @@
+// Feather-m4-can_bot_example/host/eval_batch.cpp
+/**
+ * @file eval_batch.cpp
+ * @brief Command line front end of the batch evaluation C interface
+ *
+ * Scores a file of tron_position records (see TronEvalApi.h) or a generated sample of
+ * self-play positions, and writes one CSV line per position.
+ *
+ *   pio run -e native_eval_batch && .pio/build/native_eval_batch/program --random 100000 --kind move
+ *
+ * Options:
+ *   --input FILE     raw tron_position records to score
+ *   --random N       score N positions sampled from self-play games instead
+ *   --save FILE      also write the scored positions as raw records
+ *   --output FILE    CSV with index,up,right,down,left,best,nodes (default: no output)
+ *   --kind K         area, move or search (default move)
+ *   --depth D        search depth for --kind search (default 4)
+ *   --threads N      worker threads, 0 = all hardware threads (default 0)
+ *   --tt-bits B      log2 of the transposition table slots per thread (default 16)
+ *   --seed S         seed of --random (default 1)
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "TronEvalApi.h"
+#include "TronSim.h"
+#include "TunedWeights.h"
+
+namespace
+{
+struct Options
+{
+    std::string input;
+    std::string save;
+    std::string output;
+    unsigned random = 0;
+    uint32_t seed = 1;
+    tron_eval_options eval;
+};
+
+/**
+ * Samples positions from self-play games: every tick, one live player's view
+ */
+void samplePositions(std::vector<tron_position> &positions, unsigned wanted, uint32_t seed)
+{
+    SimPolicy policies[NUM_PLAYERS];
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+        policies[i] = weightedPolicy(TUNED_WEIGHTS);
+
+    uint8_t owners[GRID_WIDTH * GRID_HEIGHT];
+    for (uint32_t game = 0; positions.size() < wanted; game++)
+    {
+        SimOptions options;
+        options.seed = seed + game;
+        playGame(policies, options, [&](const TronState &state, const uint8_t *) {
+            if (positions.size() >= wanted || __builtin_popcount(state.alive) < 2)
+                return;
+            tron_position position;
+            memset(&position, 0, sizeof(position));
+            memcpy(owners, state.grid, sizeof(owners));
+            tron_eval_pack_cells(&position, owners);
+            for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+            {
+                position.head_x[i] = state.x[i];
+                position.head_y[i] = state.y[i];
+                position.heading[i] = state.heading[i];
+            }
+            // Rotate through the live players
+            position.me = positions.size() % NUM_PLAYERS;
+            while (!(state.alive & (1 << position.me)))
+                position.me = (position.me + 1) % NUM_PLAYERS;
+            positions.push_back(position);
+        });
+    }
+}
+
+bool parseOptions(int argc, char **argv, Options &options)
+{
+    tron_eval_default_options(&options.eval);
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const char *value = argv[i + 1];
+        if (!strcmp(argv[i], "--input"))
+            options.input = value;
+        else if (!strcmp(argv[i], "--random"))
+            options.random = (unsigned)strtoul(value, nullptr, 0);
+        else if (!strcmp(argv[i], "--save"))
+            options.save = value;
+        else if (!strcmp(argv[i], "--output"))
+            options.output = value;
+        else if (!strcmp(argv[i], "--kind"))
+        {
+            if (!strcmp(value, "area"))
+                options.eval.kind = TRON_EVAL_AREA;
+            else if (!strcmp(value, "move"))
+                options.eval.kind = TRON_EVAL_MOVE;
+            else if (!strcmp(value, "search"))
+                options.eval.kind = TRON_EVAL_SEARCH;
+            else
+                return false;
+        }
+        else if (!strcmp(argv[i], "--depth"))
+            options.eval.search_depth = (uint32_t)strtoul(value, nullptr, 0);
+        else if (!strcmp(argv[i], "--threads"))
+            options.eval.threads = (uint32_t)strtoul(value, nullptr, 0);
+        else if (!strcmp(argv[i], "--tt-bits"))
+            options.eval.tt_bits = (uint32_t)strtoul(value, nullptr, 0);
+        else if (!strcmp(argv[i], "--seed"))
+            options.seed = (uint32_t)strtoul(value, nullptr, 0);
+        else
+        {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return false;
+        }
+    }
+    if (argc % 2 == 0)
+    {
+        fprintf(stderr, "Missing value for %s\n", argv[argc - 1]);
+        return false;
+    }
+    return options.input.empty() != (options.random == 0);
+}
+
+bool readPositions(const std::string &path, std::vector<tron_position> &positions)
+{
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file)
+        return false;
+    tron_position position;
+    while (fread(&position, sizeof(position), 1, file) == 1)
+        positions.push_back(position);
+    fclose(file);
+    return true;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        fprintf(stderr, "Usage: %s (--input FILE | --random N) [--kind area|move|search] [--output FILE] ...\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<tron_position> positions;
+    if (!options.input.empty() && !readPositions(options.input, positions))
+    {
+        fprintf(stderr, "Cannot read %s\n", options.input.c_str());
+        return 1;
+    }
+    if (options.random)
+        samplePositions(positions, options.random, options.seed);
+
+    if (!options.save.empty())
+    {
+        FILE *file = fopen(options.save.c_str(), "wb");
+        if (!file || fwrite(positions.data(), sizeof(tron_position), positions.size(), file) != positions.size())
+        {
+            fprintf(stderr, "Cannot write %s\n", options.save.c_str());
+            return 1;
+        }
+        fclose(file);
+    }
+
+    std::vector<tron_scores> scores(positions.size());
+    auto start = std::chrono::steady_clock::now();
+    int status = tron_eval_batch(positions.data(), positions.size(), &options.eval, scores.data());
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if (status != TRON_EVAL_OK)
+    {
+        fprintf(stderr, "tron_eval_batch failed with status %d\n", status);
+        return 1;
+    }
+
+    uint64_t nodes = 0;
+    for (const tron_scores &s : scores)
+        nodes += s.nodes;
+    fprintf(stderr, "%u positions in %.3f s: %.0f positions/s", (unsigned)positions.size(), elapsed.count(),
+            positions.size() / elapsed.count());
+    if (nodes)
+        fprintf(stderr, ", %.2f Mnodes/s", nodes / elapsed.count() / 1e6);
+    fprintf(stderr, "\n");
+
+    if (!options.output.empty())
+    {
+        FILE *file = fopen(options.output.c_str(), "w");
+        if (!file)
+        {
+            fprintf(stderr, "Cannot write %s\n", options.output.c_str());
+            return 1;
+        }
+        fprintf(file, "index,up,right,down,left,best,nodes\n");
+        for (size_t i = 0; i < scores.size(); i++)
+        {
+            const tron_scores &s = scores[i];
+            fprintf(file, "%u", (unsigned)i);
+            for (int d = 0; d < 4; d++)
+            {
+                if (s.score[d] == TRON_EVAL_NO_SCORE)
+                    fprintf(file, ",");
+                else
+                    fprintf(file, ",%g", s.score[d]);
+            }
+            fprintf(file, ",%u,%llu\n", s.best, (unsigned long long)s.nodes);
+        }
+        fclose(file);
+    }
+    return 0;
+}
@@ -0,0 +1,264 @@
+// Feather-m4-can_bot_example/host/mlp_bench.cpp
+/**
+ * @file mlp_bench.cpp
+ * @brief Checks and benchmarks the quantized move network against the one-ply heuristic
+ *
+ * Three parts:
+ * - Bit-exactness: mlpScore() (packed dual multiply-accumulate) against mlpScoreReference()
+ *   on the features of real positions and on random feature vectors
+ * - Latency of one move decision, mlpChooseMove() against chooseMove() on the same positions
+ * - Strength: one network player against three heuristic players, the network on seat g % 4
+ *   in game g, scored like the tuner (points above the average of the three others)
+ *
+ * The latency here is that of the portable lanes on the PC; on the M4 the dot products run on
+ * SMLAD, so only the ratio to chooseMove() is meaningful.
+ *
+ *   pio run -e native_mlp_bench && .pio/build/native_mlp_bench/program --games 400
+ *
+ * Options:
+ *   --games N        games of the strength match (default 400)
+ *   --random N       random feature vectors of the exactness check (default 100000)
+ *   --threads N      match threads (default: all hardware threads)
+ *   --seed S         first game seed (default 1000000, away from the training games)
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "Evaluation.h"
+#include "MlpEval.h"
+#include "TronSim.h"
+#include "TunedWeights.h"
+#include "WorkStealingPool.h"
+
+namespace
+{
+struct Options
+{
+    unsigned games = 400;
+    unsigned random = 100000;
+    unsigned threads = 0;
+    uint32_t seed = 1000000;
+};
+
+struct Position
+{
+    TronState state;
+    uint8_t me;
+};
+
+uint32_t nextRandom(uint32_t &rng)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+SimPolicy mlpPolicy()
+{
+    return [](const TronState &state, uint8_t me) {
+        uint8_t heads[NUM_PLAYERS][2];
+        headsOf(state, heads);
+        return mlpChooseMove(state.grid, heads, me, state.heading[me]);
+    };
+}
+
+/**
+ * Every tick of a few heuristic games, for every living player
+ */
+void collectPositions(std::vector<Position> &positions, uint32_t seed)
+{
+    SimPolicy policies[NUM_PLAYERS];
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+        policies[i] = weightedPolicy(TUNED_WEIGHTS);
+    for (uint32_t game = 0; game < 8; game++)
+    {
+        SimOptions options;
+        options.seed = seed + game;
+        playGame(policies, options, [&](const TronState &state, const uint8_t *) {
+            for (uint8_t me = 0; me < NUM_PLAYERS; me++)
+            {
+                if (state.alive & (1 << me))
+                    positions.push_back({state, me});
+            }
+        });
+    }
+}
+
+unsigned checkExactness(const std::vector<Position> &positions, unsigned randomCount, uint32_t seed)
+{
+    unsigned mismatches = 0;
+    unsigned checked = 0;
+    int8_t features[MLP_INPUTS];
+    uint8_t heads[NUM_PLAYERS][2];
+    for (const Position &position : positions)
+    {
+        const TronState &state = position.state;
+        headsOf(state, heads);
+        for (uint8_t dir = DIR_UP; dir <= DIR_LEFT; dir++)
+        {
+            if (isReverse(dir, state.heading[position.me]))
+                continue;
+            uint8_t nx = wrapX(state.x[position.me] + dx[dir - 1]);
+            uint8_t ny = wrapY(state.y[position.me] + dy[dir - 1]);
+            int area = state.grid[nx][ny] ? 0 : calculateAccessibleArea(state.grid, nx, ny);
+            mlpFeatures(state.grid, heads, position.me, state.heading[position.me], dir, area, features);
+            mismatches += mlpScore(features) != mlpScoreReference(features);
+            checked++;
+        }
+    }
+
+    // The full int8 range, including the negative values the features never take
+    uint32_t rng = seed ? seed : 1;
+    for (unsigned n = 0; n < randomCount; n++)
+    {
+        for (uint8_t i = 0; i < MLP_INPUTS; i++)
+            features[i] = (int8_t)(nextRandom(rng) & 0xFF);
+        mismatches += mlpScore(features) != mlpScoreReference(features);
+        checked++;
+    }
+    printf("Exactness: %u feature vectors, %u mismatches\n", checked, mismatches);
+    return mismatches;
+}
+
+template <typename Choose> double timeDecisions(const std::vector<Position> &positions, Choose choose, unsigned &checksum)
+{
+    uint8_t heads[NUM_PLAYERS][2];
+    auto start = std::chrono::steady_clock::now();
+    for (const Position &position : positions)
+    {
+        headsOf(position.state, heads);
+        checksum += choose(position.state, heads, position.me);
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / positions.size();
+}
+
+void measureLatency(const std::vector<Position> &positions)
+{
+    unsigned checksum = 0;
+    unsigned agree = 0;
+    double heuristic = timeDecisions(positions, [](const TronState &state, const uint8_t heads[][2], uint8_t me) {
+        return chooseMove(state.grid, heads, me, state.heading[me], TUNED_WEIGHTS);
+    }, checksum);
+    double network = timeDecisions(positions, [](const TronState &state, const uint8_t heads[][2], uint8_t me) {
+        return mlpChooseMove(state.grid, heads, me, state.heading[me]);
+    }, checksum);
+
+    // The network score alone, without features and flood fills
+    int8_t features[MLP_INPUTS] = {};
+    int32_t sink = 0;
+    const unsigned SCORES = 1000000;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned n = 0; n < SCORES; n++)
+    {
+        features[n % MLP_INPUTS] = (int8_t)(n & 0x7F);
+        sink += mlpScore(features);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    uint8_t heads[NUM_PLAYERS][2];
+    for (const Position &position : positions)
+    {
+        const TronState &state = position.state;
+        headsOf(state, heads);
+        agree += chooseMove(state.grid, heads, position.me, state.heading[position.me], TUNED_WEIGHTS) ==
+                 mlpChooseMove(state.grid, heads, position.me, state.heading[position.me]);
+    }
+    printf("Latency over %u decisions: chooseMove %.1f us, mlpChooseMove %.1f us (network %.0f ns per move)\n",
+           (unsigned)positions.size(), heuristic, network, elapsed.count() / SCORES);
+    printf("Same move as the heuristic: %.1f%%  (checksum %u, %ld)\n", 100.0 * agree / positions.size(), checksum,
+           (long)(sink & 1));
+}
+
+void playMatch(WorkStealingPool &pool, unsigned games, uint32_t firstSeed)
+{
+    std::vector<int> advantage(games);
+    std::vector<uint8_t> won(games);
+    WorkStealingPool::TaskGroup group;
+    for (unsigned g = 0; g < games; g++)
+    {
+        pool.run(group, [&, g] {
+            SimPolicy policies[NUM_PLAYERS];
+            for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+                policies[i] = i == g % NUM_PLAYERS ? mlpPolicy() : weightedPolicy(TUNED_WEIGHTS);
+            SimOptions options;
+            options.seed = firstSeed + g;
+            SimGameResult result = playGame(policies, options);
+            int others = 0;
+            uint8_t best = 0;
+            for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+            {
+                others += i == g % NUM_PLAYERS ? 0 : result.points[i];
+                best = result.points[i] > best ? result.points[i] : best;
+            }
+            // In thirds of a point, to stay in integers
+            advantage[g] = 3 * result.points[g % NUM_PLAYERS] - others;
+            won[g] = result.points[g % NUM_PLAYERS] == best;
+        });
+    }
+    pool.wait(group);
+
+    int total = 0;
+    unsigned wins = 0;
+    for (unsigned g = 0; g < games; g++)
+    {
+        total += advantage[g];
+        wins += won[g];
+    }
+    printf("Match over %u games: network %+.3f points per game against the heuristic, "
+           "most points (shared included) in %.1f%% of games (25%% is equal strength)\n",
+           games, total / 3.0 / games, 100.0 * wins / games);
+}
+
+bool parseOptions(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        unsigned value = (unsigned)strtoul(argv[i + 1], nullptr, 0);
+        if (!strcmp(argv[i], "--games"))
+            options.games = value;
+        else if (!strcmp(argv[i], "--random"))
+            options.random = value;
+        else if (!strcmp(argv[i], "--threads"))
+            options.threads = value;
+        else if (!strcmp(argv[i], "--seed"))
+            options.seed = value;
+        else
+        {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return false;
+        }
+    }
+    if (argc % 2 == 0)
+    {
+        fprintf(stderr, "Missing value for %s\n", argv[argc - 1]);
+        return false;
+    }
+    return true;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+        return 2;
+    if (!options.threads)
+        options.threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+
+    std::vector<Position> positions;
+    collectPositions(positions, options.seed);
+    unsigned mismatches = checkExactness(positions, options.random, options.seed);
+    measureLatency(positions);
+
+    WorkStealingPool pool(options.threads);
+    if (options.games)
+        playMatch(pool, options.games, options.seed);
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,588 @@
+// Feather-m4-can_bot_example/host/mlp_train.cpp
+/**
+ * @file mlp_train.cpp
+ * @brief Trains the move network of MlpEval.h and writes include/MlpWeights.h
+ *
+ * Positions come from self-play games of the one-ply evaluation. In each one, every free
+ * forward move is searched to the given depth; the target is the best of them, ties broken by
+ * the one-ply evaluation (like the opening book). So the network learns the search where it
+ * sees a difference and the tuned heuristic where it does not.
+ *
+ * The float network is trained with a softmax over the candidate moves and Adam, then
+ * quantized: int8 weights with one scale per hidden unit (folded into the output weights),
+ * int32 biases, and the right shift after the first layer that makes the integer network pick
+ * the float network's move most often. Top-1 agreement with the search on held-out positions is reported for the float
+ * and the quantized network and for the heuristic.
+ *
+ *   pio run -e native_mlp_train && .pio/build/native_mlp_train/program --positions 20000 --depth 3
+ *
+ * Options:
+ *   --positions N    positions to label (default 20000)
+ *   --depth D        search depth of the labels (default 3)
+ *   --epochs N       passes over the training positions (default 60)
+ *   --threads N      labelling threads (default: all hardware threads)
+ *   --seed S         seed of games, initialization and shuffling (default 1)
+ *   --output PATH    generated header (default include/MlpWeights.h)
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Evaluation.h"
+#include "MlpEval.h"
+#include "TronSearch.h"
+#include "TronSim.h"
+#include "TunedWeights.h"
+#include "WorkStealingPool.h"
+
+namespace
+{
+struct Options
+{
+    unsigned positions = 20000;
+    unsigned depth = 3;
+    unsigned epochs = 60;
+    unsigned threads = 0;
+    uint32_t seed = 1;
+    std::string output = "include/MlpWeights.h";
+};
+
+const size_t TT_SLOTS = 1 << 16;
+const float SEARCH_WINDOW = 1.0e9f;
+const unsigned SAMPLE_ONE_IN = 8; // Ticks between sampled positions, on average
+const double HOLDOUT = 0.1;
+const unsigned BATCH = 64;
+const double LEARNING_RATE = 3e-3;
+
+struct Sample
+{
+    TronState state;
+    uint8_t me;
+    uint8_t count;                              // Free forward moves
+    uint8_t dirs[MAX_OUR_MOVES];
+    int8_t features[MAX_OUR_MOVES][MLP_INPUTS];
+    uint8_t target;                             // Index of the search move
+    uint8_t heuristic;                          // Index of the chooseMove() move, 0xFF if not free
+};
+
+struct Network
+{
+    float w1[MLP_HIDDEN][MLP_INPUTS];
+    float b1[MLP_HIDDEN];
+    float w2[MLP_HIDDEN];
+    float b2;
+};
+
+const size_t PARAMETERS = sizeof(Network) / sizeof(float);
+
+struct Quantized
+{
+    int8_t w1[MLP_HIDDEN][MLP_INPUTS];
+    int32_t b1[MLP_HIDDEN];
+    int8_t w2[MLP_HIDDEN];
+    int32_t b2;
+    uint8_t shift;
+};
+
+uint32_t nextRandom(uint32_t &rng)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+double uniform(uint32_t &rng)
+{
+    return (nextRandom(rng) >> 8) / 16777216.0;
+}
+
+/**
+ * Self-play positions with at least two free forward moves for the sampled player
+ */
+void samplePositions(std::vector<Sample> &samples, unsigned wanted, uint32_t seed)
+{
+    SimPolicy policies[NUM_PLAYERS];
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+        policies[i] = weightedPolicy(TUNED_WEIGHTS);
+
+    uint32_t rng = seed;
+    for (uint32_t game = 0; samples.size() < wanted; game++)
+    {
+        SimOptions options;
+        options.seed = seed + game;
+        playGame(policies, options, [&](const TronState &state, const uint8_t *) {
+            if (samples.size() >= wanted || nextRandom(rng) % SAMPLE_ONE_IN || __builtin_popcount(state.alive) < 2)
+                return;
+            uint8_t me = nextRandom(rng) % NUM_PLAYERS;
+            if (!(state.alive & (1 << me)))
+                return;
+
+            Sample sample;
+            sample.count = 0;
+            for (uint8_t dir = DIR_UP; dir <= DIR_LEFT; dir++)
+            {
+                if (!isReverse(dir, state.heading[me]) &&
+                    !state.grid[wrapX(state.x[me] + dx[dir - 1])][wrapY(state.y[me] + dy[dir - 1])])
+                    sample.dirs[sample.count++] = dir;
+            }
+            if (sample.count < 2)
+                return;
+            memcpy(&sample.state, &state, sizeof(TronState));
+            sample.me = me;
+            samples.push_back(sample);
+        });
+    }
+}
+
+/**
+ * Fills features, target and heuristic move of a sampled position
+ */
+void labelSample(Sample &sample, uint8_t depth, TranspositionTable &tt)
+{
+    const TronState &state = sample.state;
+    const uint8_t me = sample.me;
+    uint8_t heads[NUM_PLAYERS][2];
+    headsOf(state, heads);
+
+    uint8_t starts[MAX_FILL_REGIONS][2];
+    for (uint8_t k = 0; k < sample.count; k++)
+    {
+        starts[k][0] = wrapX(state.x[me] + dx[sample.dirs[k] - 1]);
+        starts[k][1] = wrapY(state.y[me] + dy[sample.dirs[k] - 1]);
+    }
+    int areas[MAX_FILL_REGIONS];
+    compareAccessibleAreas(state.grid, starts, sample.count, -1, 0, areas);
+
+    SearchContext context = {me, &tt, 0};
+    uint8_t replies[MAX_REPLIES][NUM_PLAYERS];
+    uint8_t replyCount = generateReplies(state, me, depth, replies);
+    TronState child;
+    float bestValue = -SEARCH_WINDOW;
+    float bestTieBreak = 0.0f;
+    sample.target = 0;
+    for (uint8_t k = 0; k < sample.count; k++)
+    {
+        mlpFeatures(state.grid, heads, me, state.heading[me], sample.dirs[k], areas[k], sample.features[k]);
+
+        float value = SEARCH_WINDOW;
+        for (uint8_t r = 0; r < replyCount; r++)
+        {
+            memcpy(&child, &state, sizeof(TronState));
+            replies[r][me] = sample.dirs[k];
+            applyMoves(child, replies[r]);
+            value = std::min(value, searchValue(context, child, depth - 1, -SEARCH_WINDOW, value));
+        }
+        float tieBreak = evaluateMove(state.grid, heads, me, state.heading[me], sample.dirs[k], TUNED_WEIGHTS);
+        if (k == 0 || value > bestValue || (value == bestValue && tieBreak > bestTieBreak))
+        {
+            bestValue = value;
+            bestTieBreak = tieBreak;
+            sample.target = k;
+        }
+    }
+
+    uint8_t heuristic = chooseMove(state.grid, heads, me, state.heading[me], TUNED_WEIGHTS);
+    sample.heuristic = 0xFF;
+    for (uint8_t k = 0; k < sample.count; k++)
+    {
+        if (sample.dirs[k] == heuristic)
+            sample.heuristic = k;
+    }
+}
+
+float forward(const Network &net, const int8_t features[MLP_INPUTS], float hidden[MLP_HIDDEN])
+{
+    float score = net.b2;
+    for (uint8_t h = 0; h < MLP_HIDDEN; h++)
+    {
+        float acc = net.b1[h];
+        for (uint8_t i = 0; i < MLP_INPUTS; i++)
+            acc += net.w1[h][i] * (features[i] / (float)MLP_ONE);
+        hidden[h] = acc > 0.0f ? acc : 0.0f;
+        score += net.w2[h] * hidden[h];
+    }
+    return score;
+}
+
+/**
+ * Softmax cross-entropy of one position; adds its gradient
+ */
+double accumulate(const Network &net, const Sample &sample, Network &gradient)
+{
+    float hidden[MAX_OUR_MOVES][MLP_HIDDEN];
+    float scores[MAX_OUR_MOVES];
+    float top = -1e30f;
+    for (uint8_t k = 0; k < sample.count; k++)
+    {
+        scores[k] = forward(net, sample.features[k], hidden[k]);
+        top = std::max(top, scores[k]);
+    }
+    double total = 0.0;
+    double probability[MAX_OUR_MOVES];
+    for (uint8_t k = 0; k < sample.count; k++)
+    {
+        probability[k] = std::exp((double)(scores[k] - top));
+        total += probability[k];
+    }
+
+    for (uint8_t k = 0; k < sample.count; k++)
+    {
+        probability[k] /= total;
+        float delta = (float)(probability[k] - (k == sample.target ? 1.0 : 0.0));
+        gradient.b2 += delta;
+        for (uint8_t h = 0; h < MLP_HIDDEN; h++)
+        {
+            gradient.w2[h] += delta * hidden[k][h];
+            if (hidden[k][h] <= 0.0f)
+                continue;
+            float back = delta * net.w2[h];
+            gradient.b1[h] += back;
+            for (uint8_t i = 0; i < MLP_INPUTS; i++)
+                gradient.w1[h][i] += back * (sample.features[k][i] / (float)MLP_ONE);
+        }
+    }
+    return -std::log(probability[sample.target]);
+}
+
+void train(Network &net, const std::vector<Sample> &samples, size_t trainCount, unsigned epochs, uint32_t &rng)
+{
+    float *params = reinterpret_cast<float *>(&net);
+    for (uint8_t h = 0; h < MLP_HIDDEN; h++)
+    {
+        for (uint8_t i = 0; i < MLP_INPUTS; i++)
+            net.w1[h][i] = (float)((uniform(rng) * 2.0 - 1.0) * std::sqrt(6.0 / (MLP_INPUTS + MLP_HIDDEN)));
+        net.b1[h] = 0.1f;
+        net.w2[h] = (float)((uniform(rng) * 2.0 - 1.0) * std::sqrt(6.0 / (MLP_HIDDEN + 1)));
+    }
+    net.b2 = 0.0f;
+
+    // Adam
+    std::vector<double> m(PARAMETERS, 0.0);
+    std::vector<double> v(PARAMETERS, 0.0);
+    std::vector<size_t> order(trainCount);
+    for (size_t i = 0; i < trainCount; i++)
+        order[i] = i;
+    uint64_t step = 0;
+
+    for (unsigned epoch = 0; epoch < epochs; epoch++)
+    {
+        for (size_t i = trainCount; i > 1; i--)
+            std::swap(order[i - 1], order[nextRandom(rng) % i]);
+        double rate = LEARNING_RATE * (epoch < epochs / 2 ? 1.0 : (epoch < 3 * epochs / 4 ? 0.3 : 0.1));
+
+        double loss = 0.0;
+        for (size_t start = 0; start < trainCount; start += BATCH)
+        {
+            Network gradient;
+            memset(&gradient, 0, sizeof(gradient));
+            size_t end = std::min(trainCount, start + BATCH);
+            for (size_t i = start; i < end; i++)
+                loss += accumulate(net, samples[order[i]], gradient);
+
+            step++;
+            const float *g = reinterpret_cast<const float *>(&gradient);
+            for (size_t p = 0; p < PARAMETERS; p++)
+            {
+                double grad = g[p] / (double)(end - start);
+                m[p] = 0.9 * m[p] + 0.1 * grad;
+                v[p] = 0.999 * v[p] + 0.001 * grad * grad;
+                double mHat = m[p] / (1.0 - std::pow(0.9, (double)step));
+                double vHat = v[p] / (1.0 - std::pow(0.999, (double)step));
+                params[p] -= (float)(rate * mHat / (std::sqrt(vHat) + 1e-8));
+            }
+        }
+        if (epoch % 10 == 9 || epoch + 1 == epochs)
+            printf("epoch %3u  loss %.4f\n", epoch + 1, loss / trainCount);
+    }
+}
+
+/**
+ * Quantizes with one scale per hidden unit. ReLU commutes with positive scaling, so unit h can
+ * use its own weight scale s_h as long as W2[h] is divided by it; the firmware only sees the
+ * integer weights and the one shift. s_h is capped by the int8 range of the row and by the
+ * 99.9th percentile of the unit's activations, which must land at MLP_ONE after the shift.
+ */
+Quantized quantizeWithShift(const Network &net, const float top[MLP_HIDDEN], uint8_t shift)
+{
+    Quantized q;
+    q.shift = shift;
+    double hiddenScale[MLP_HIDDEN]; // Integer units per float unit of each hidden activation
+    double maxW2 = 1e-12;
+    for (uint8_t h = 0; h < MLP_HIDDEN; h++)
+    {
+        float maxW1 = 1e-6f;
+        for (uint8_t i = 0; i < MLP_INPUTS; i++)
+            maxW1 = std::max(maxW1, std::fabs(net.w1[h][i]));
+        double s = std::min((double)MLP_ONE / maxW1, std::pow(2.0, shift) / top[h]);
+        for (uint8_t i = 0; i < MLP_INPUTS; i++)
+            q.w1[h][i] = (int8_t)std::lround(net.w1[h][i] * s);
+        q.b1[h] = (int32_t)std::lround(net.b1[h] * s * MLP_ONE);
+        hiddenScale[h] = s * MLP_ONE / std::pow(2.0, shift);
+        maxW2 = std::max(maxW2, std::fabs(net.w2[h] / hiddenScale[h]));
+    }
+    double s2 = MLP_ONE / maxW2;
+    for (uint8_t h = 0; h < MLP_HIDDEN; h++)
+        q.w2[h] = (int8_t)std::lround(net.w2[h] / hiddenScale[h] * s2);
+    q.b2 = (int32_t)std::lround(net.b2 * s2);
+    return q;
+}
+
+int32_t quantizedScore(const Quantized &q, const int8_t features[MLP_INPUTS]);
+
+/**
+ * Moves of the training positions on which the integer and the float network agree
+ */
+unsigned agreeWithFloat(const Network &net, const Quantized &q, const std::vector<Sample> &samples, size_t trainCount)
+{
+    unsigned same = 0;
+    float hidden[MLP_HIDDEN];
+    for (size_t n = 0; n < trainCount; n++)
+    {
+        const Sample &sample = samples[n];
+        uint8_t bestFloat = 0;
+        uint8_t bestInt = 0;
+        float topFloat = 0.0f;
+        int32_t topInt = 0;
+        for (uint8_t k = 0; k < sample.count; k++)
+        {
+            float f = forward(net, sample.features[k], hidden);
+            int32_t i = quantizedScore(q, sample.features[k]);
+            if (k == 0 || f > topFloat)
+            {
+                topFloat = f;
+                bestFloat = k;
+            }
+            if (k == 0 || i > topInt)
+            {
+                topInt = i;
+                bestInt = k;
+            }
+        }
+        same += bestFloat == bestInt;
+    }
+    return same;
+}
+
+Quantized quantize(const Network &net, const std::vector<Sample> &samples, size_t trainCount)
+{
+    std::vector<float> activations[MLP_HIDDEN];
+    float hidden[MLP_HIDDEN];
+    for (size_t n = 0; n < trainCount; n++)
+    {
+        for (uint8_t k = 0; k < samples[n].count; k++)
+        {
+            forward(net, samples[n].features[k], hidden);
+            for (uint8_t h = 0; h < MLP_HIDDEN; h++)
+                activations[h].push_back(hidden[h]);
+        }
+    }
+    float top[MLP_HIDDEN];
+    for (uint8_t h = 0; h < MLP_HIDDEN; h++)
+    {
+        size_t index = (size_t)(activations[h].size() * 0.999);
+        std::nth_element(activations[h].begin(), activations[h].begin() + index, activations[h].end());
+        top[h] = std::max(activations[h][index], 1e-3f);
+    }
+
+    // A larger shift gives the units with large weights more activation range and the others
+    // less weight range; keep the one that follows the float network best
+    Quantized best = quantizeWithShift(net, top, 0);
+    unsigned bestSame = agreeWithFloat(net, best, samples, trainCount);
+    for (uint8_t shift = 1; shift <= 20; shift++)
+    {
+        Quantized q = quantizeWithShift(net, top, shift);
+        unsigned same = agreeWithFloat(net, q, samples, trainCount);
+        if (same > bestSame)
+        {
+            best = q;
+            bestSame = same;
+        }
+    }
+    return best;
+}
+
+/**
+ * Integer inference with the new weights, as mlpScoreReference()
+ */
+int32_t quantizedScore(const Quantized &q, const int8_t features[MLP_INPUTS])
+{
+    int32_t score = q.b2;
+    for (uint8_t h = 0; h < MLP_HIDDEN; h++)
+    {
+        int32_t acc = q.b1[h];
+        for (uint8_t i = 0; i < MLP_INPUTS; i++)
+            acc += q.w1[h][i] * features[i];
+        acc >>= q.shift;
+        score += q.w2[h] * (acc < 0 ? 0 : (acc > MLP_ONE ? MLP_ONE : acc));
+    }
+    return score;
+}
+
+struct Agreement
+{
+    double network;
+    double quantized;
+    double heuristic;
+};
+
+Agreement measure(const Network &net, const Quantized &q, const std::vector<Sample> &samples, size_t from, size_t to)
+{
+    unsigned network = 0;
+    unsigned quantized = 0;
+    unsigned heuristic = 0;
+    float hidden[MLP_HIDDEN];
+    for (size_t n = from; n < to; n++)
+    {
+        const Sample &sample = samples[n];
+        uint8_t bestFloat = 0;
+        uint8_t bestInt = 0;
+        float topFloat = 0.0f;
+        int32_t topInt = 0;
+        for (uint8_t k = 0; k < sample.count; k++)
+        {
+            float f = forward(net, sample.features[k], hidden);
+            int32_t i = quantizedScore(q, sample.features[k]);
+            if (k == 0 || f > topFloat)
+            {
+                topFloat = f;
+                bestFloat = k;
+            }
+            if (k == 0 || i > topInt)
+            {
+                topInt = i;
+                bestInt = k;
+            }
+        }
+        network += bestFloat == sample.target;
+        quantized += bestInt == sample.target;
+        heuristic += sample.heuristic == sample.target;
+    }
+    double count = to > from ? (double)(to - from) : 1.0;
+    return {network / count, quantized / count, heuristic / count};
+}
+
+void printArray(FILE *file, const int8_t *values, unsigned count, const char *indent)
+{
+    for (unsigned i = 0; i < count; i++)
+        fprintf(file, "%s%4d,%s", i % 14 == 0 ? indent : "", values[i], i % 14 == 13 || i + 1 == count ? "\n" : "");
+}
+
+bool writeHeader(const Options &options, const Quantized &q, size_t positions, const Agreement &holdout)
+{
+    FILE *file = fopen(options.output.c_str(), "w");
+    if (!file)
+    {
+        fprintf(stderr, "Cannot write %s\n", options.output.c_str());
+        return false;
+    }
+    fprintf(file, "// Feather-m4-can_bot_example/include/MlpWeights.h\n");
+    fprintf(file, "// Generated by host/mlp_train.cpp - do not edit by hand, rerun the trainer instead.\n");
+    fprintf(file, "// %u positions, search depth %u, %u epochs, seed %u. Held-out agreement with the search:\n",
+            (unsigned)positions, options.depth, options.epochs, (unsigned)options.seed);
+    fprintf(file, "// network %.1f%%, heuristic %.1f%%.\n", 100.0 * holdout.quantized, 100.0 * holdout.heuristic);
+    fprintf(file, "\n#ifndef MLP_WEIGHTS_H\n#define MLP_WEIGHTS_H\n\n#include \"MlpEval.h\"\n\n");
+    fprintf(file, "// Right shift of the first-layer accumulators before the ReLU clamp\n");
+    fprintf(file, "constexpr uint8_t MLP_SHIFT = %u;\n\n", q.shift);
+    fprintf(file, "alignas(4) constexpr int8_t MLP_W1[MLP_HIDDEN][MLP_INPUTS] = {\n");
+    for (uint8_t h = 0; h < MLP_HIDDEN; h++)
+    {
+        fprintf(file, "    {\n");
+        printArray(file, q.w1[h], MLP_INPUTS, "        ");
+        fprintf(file, "    },\n");
+    }
+    fprintf(file, "};\n\nconstexpr int32_t MLP_B1[MLP_HIDDEN] = {\n");
+    for (uint8_t h = 0; h < MLP_HIDDEN; h++)
+        fprintf(file, "%s%ld,%s", h % 8 == 0 ? "    " : " ", (long)q.b1[h], h % 8 == 7 ? "\n" : "");
+    fprintf(file, "};\n\nalignas(4) constexpr int8_t MLP_W2[MLP_HIDDEN] = {\n");
+    printArray(file, q.w2, MLP_HIDDEN, "    ");
+    fprintf(file, "};\n\nconstexpr int32_t MLP_B2 = %ld;\n\n#endif\n", (long)q.b2);
+    fclose(file);
+    return true;
+}
+
+bool parseOptions(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        unsigned value = (unsigned)strtoul(argv[i + 1], nullptr, 0);
+        if (!strcmp(argv[i], "--positions"))
+            options.positions = value;
+        else if (!strcmp(argv[i], "--depth"))
+            options.depth = value;
+        else if (!strcmp(argv[i], "--epochs"))
+            options.epochs = value;
+        else if (!strcmp(argv[i], "--threads"))
+            options.threads = value;
+        else if (!strcmp(argv[i], "--seed"))
+            options.seed = value;
+        else if (!strcmp(argv[i], "--output"))
+            options.output = argv[i + 1];
+        else
+        {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return false;
+        }
+    }
+    if (argc % 2 == 0)
+    {
+        fprintf(stderr, "Missing value for %s\n", argv[argc - 1]);
+        return false;
+    }
+    return options.positions >= 100 && options.depth >= 1 && options.depth <= SEARCH_MAX_DEPTH && options.epochs > 0;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+        return 2;
+    if (!options.threads)
+        options.threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Sample> samples;
+    samplePositions(samples, options.positions, options.seed);
+
+    WorkStealingPool pool(options.threads);
+    WorkStealingPool::TaskGroup group;
+    for (size_t n = 0; n < samples.size(); n++)
+    {
+        pool.run(group, [&, n] {
+            thread_local std::unique_ptr<TranspositionTable::Slot[]> slots(new TranspositionTable::Slot[TT_SLOTS]);
+            thread_local TranspositionTable tt(slots.get(), TT_SLOTS);
+            labelSample(samples[n], (uint8_t)options.depth, tt);
+        });
+    }
+    pool.wait(group);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    printf("Labelled %u positions at depth %u in %.1f s\n", (unsigned)samples.size(), options.depth, elapsed.count());
+
+    // Positions of the last games are held out
+    size_t trainCount = samples.size() - (size_t)(samples.size() * HOLDOUT);
+    uint32_t rng = options.seed ? options.seed : 1;
+    static Network net;
+    train(net, samples, trainCount, options.epochs, rng);
+    Quantized q = quantize(net, samples, trainCount);
+
+    Agreement training = measure(net, q, samples, 0, trainCount);
+    Agreement holdout = measure(net, q, samples, trainCount, samples.size());
+    printf("Agreement with the search  training: float %.1f%%, int8 %.1f%%, heuristic %.1f%%\n",
+           100.0 * training.network, 100.0 * training.quantized, 100.0 * training.heuristic);
+    printf("                           held out: float %.1f%%, int8 %.1f%%, heuristic %.1f%%\n",
+           100.0 * holdout.network, 100.0 * holdout.quantized, 100.0 * holdout.heuristic);
+
+    if (!writeHeader(options, q, samples.size(), holdout))
+        return 1;
+    printf("Wrote %s (shift %u)\n", options.output.c_str(), q.shift);
+    return 0;
+}
@@ -0,0 +1,190 @@
+// Feather-m4-can_bot_example/host/search_bench.cpp
+/**
+ * @file search_bench.cpp
+ * @brief Scaling benchmark of the parallel game search
+ *
+ * Generates a reproducible set of midgame positions, searches each of them with 1 to N threads
+ * and reports time, node rate, speedup and parallel efficiency per thread count. It also checks
+ * that every thread count finds the same search scores as the single-threaded run.
+ *
+ *   pio run -e native_search_bench && .pio/build/native_search_bench/program --depth 3
+ *
+ * Options:
+ *   --depth D        search depth in ticks (default 3)
+ *   --positions N    number of benchmark positions (default 24)
+ *   --threads N      highest thread count to measure (default: all hardware threads)
+ *   --tt-bits B      log2 of the transposition table slots, 0 disables it (default 20)
+ *   --seed S         seed of the position generator (default 1)
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "ParallelSearch.h"
+
+namespace
+{
+struct Options
+{
+    unsigned depth = 3;
+    unsigned positions = 24;
+    unsigned threads = 0;
+    unsigned ttBits = 20;
+    uint32_t seed = 1;
+};
+
+struct Position
+{
+    TronState state;
+    uint8_t me;
+};
+
+uint32_t nextRandom(uint32_t &rng)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+/**
+ * Plays a game in which every player greedily maximizes its flood fill (with random
+ * tie-breaks) and samples positions where an opponent is close enough to branch.
+ */
+void collectPositions(uint32_t &rng, std::vector<Position> &positions, unsigned wanted)
+{
+    TronState state;
+    initTronState(state);
+
+    for (unsigned tick = 0; positions.size() < wanted && __builtin_popcount(state.alive) > 1; tick++)
+    {
+        uint8_t moves[NUM_PLAYERS] = {DIR_NONE, DIR_NONE, DIR_NONE, DIR_NONE};
+        for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+        {
+            if (!(state.alive & (1 << i)))
+                continue;
+            int best = -1;
+            for (uint8_t dir = DIR_UP; dir <= DIR_LEFT; dir++)
+            {
+                if (isReverse(dir, state.heading[i]))
+                    continue;
+                uint8_t nx = wrapX(state.x[i] + dx[dir - 1]);
+                uint8_t ny = wrapY(state.y[i] + dy[dir - 1]);
+                int area = state.grid[nx][ny] ? -1 : calculateAccessibleArea(state.grid, nx, ny) * 4 + (int)(nextRandom(rng) % 4);
+                if (area > best)
+                {
+                    best = area;
+                    moves[i] = dir;
+                }
+            }
+        }
+        applyMoves(state, moves);
+
+        if (tick < 20 || tick % 7)
+            continue;
+        for (uint8_t me = 0; me < NUM_PLAYERS && positions.size() < wanted; me++)
+        {
+            if (!(state.alive & (1 << me)))
+                continue;
+            for (uint8_t j = 0; j < NUM_PLAYERS; j++)
+            {
+                if (j != me && (state.alive & (1 << j)) && wrappedDistance(state.x[j], state.y[j], state.x[me], state.y[me]) <= 8)
+                {
+                    positions.push_back(Position{state, me});
+                    break;
+                }
+            }
+        }
+    }
+}
+
+bool parseOptions(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        unsigned value = (unsigned)strtoul(argv[i + 1], nullptr, 0);
+        if (!strcmp(argv[i], "--depth"))
+            options.depth = value;
+        else if (!strcmp(argv[i], "--positions"))
+            options.positions = value;
+        else if (!strcmp(argv[i], "--threads"))
+            options.threads = value;
+        else if (!strcmp(argv[i], "--tt-bits"))
+            options.ttBits = value;
+        else if (!strcmp(argv[i], "--seed"))
+            options.seed = value;
+        else
+        {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return false;
+        }
+    }
+    if (argc % 2 == 0)
+    {
+        fprintf(stderr, "Missing value for %s\n", argv[argc - 1]);
+        return false;
+    }
+    return options.depth > 0 && options.positions > 0 && options.ttBits < 32;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+        return 2;
+    if (!options.threads)
+        options.threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+
+    uint32_t rng = options.seed ? options.seed : 1;
+    std::vector<Position> positions;
+    while (positions.size() < options.positions)
+        collectPositions(rng, positions, options.positions);
+
+    printf("Search scaling: %u positions, depth %u, %u hardware threads\n", (unsigned)positions.size(),
+           options.depth, std::thread::hardware_concurrency());
+    printf("%8s %10s %12s %10s %8s %10s %6s\n", "threads", "time [s]", "nodes", "Mnodes/s", "speedup", "efficiency",
+           "same");
+
+    HostTranspositionTable tt(options.ttBits ? options.ttBits : 1);
+    TranspositionTable *table = options.ttBits ? &tt : nullptr;
+    std::vector<float> reference;
+    double baseline = 0.0;
+
+    std::vector<unsigned> counts;
+    for (unsigned t = 1; t < options.threads; t *= 2)
+        counts.push_back(t);
+    counts.push_back(options.threads);
+
+    for (unsigned threads : counts)
+    {
+        WorkStealingPool pool(threads);
+        tt.clear();
+        uint64_t nodes = 0;
+        unsigned same = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < positions.size(); i++)
+        {
+            SearchResult result = searchParallel(pool, positions[i].state, positions[i].me, (uint8_t)options.depth, table);
+            nodes += result.nodes;
+            if (threads == 1)
+                reference.push_back(result.score);
+            same += result.score == reference[i];
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        double seconds = elapsed.count();
+        if (threads == 1)
+            baseline = seconds;
+        double speedup = baseline / seconds;
+        printf("%8u %10.3f %12llu %10.2f %8.2f %9.0f%% %3u/%u\n", threads, seconds, (unsigned long long)nodes,
+               nodes / seconds / 1e6, speedup, 100.0 * speedup / threads, same, (unsigned)positions.size());
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+// Feather-m4-can_bot_example/host/shim/Arduino.h
+/**
+ * @file Arduino.h
+ * @brief Host stand-in for the Arduino core, used by the bus simulation only
+ *
+ * Provides just enough of the API for the firmware sources to compile unchanged on a PC.
+ * Time is the simulated bus time set by the simulator.
+ */
+
+#ifndef HOST_SHIM_ARDUINO_H
+#define HOST_SHIM_ARDUINO_H
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#define OUTPUT 0x1
+#define INPUT 0x0
+#define HIGH 0x1
+#define LOW 0x0
+
+#define PIN_CAN_STANDBY 40
+#define PIN_CAN_BOOSTEN 4
+
+typedef volatile const uint32_t RoReg;
+
+// There is no serial number register on a PC, CANHandler.cpp uses this instead
+#define HOST_HARDWARE_ID 0x5EED0001UL
+
+namespace tronshim
+{
+// Simulated time in nanoseconds, advanced by the simulator
+extern uint64_t nowNs;
+} // namespace tronshim
+
+inline void pinMode(int, int) {}
+inline void digitalWrite(int, int) {}
+inline void delay(unsigned long) {}
+inline void noInterrupts() {} // The simulator never runs callbacks while loop() is running
+inline void interrupts() {}
+inline unsigned long millis() { return (unsigned long)(tronshim::nowNs / 1000000); }
+inline unsigned long micros() { return (unsigned long)(tronshim::nowNs / 1000); }
+
+class HardwareSerial
+{
+public:
+    void begin(unsigned long) {}
+    explicit operator bool() const { return true; }
+
+    // Output is discarded unless the simulator runs with --verbose, so logging does not
+    // end up in the measured computation time
+    bool enabled = false;
+
+    size_t print(const char *s)
+    {
+        if (!enabled)
+            return 0;
+        fputs(s, stdout);
+        return strlen(s);
+    }
+    size_t println(const char *s = "") { return print(s) + print("\n"); }
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)))
+    {
+        if (!enabled)
+            return 0;
+        va_list args;
+        va_start(args, format);
+        int n = vprintf(format, args);
+        va_end(args);
+        return n > 0 ? (size_t)n : 0;
+    }
+};
+
+extern HardwareSerial Serial;
+
+void setup();
+void loop();
+
+#endif
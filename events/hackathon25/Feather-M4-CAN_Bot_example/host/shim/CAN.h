@@ -0,0 +1,106 @@
+// Feather-m4-can_bot_example/host/shim/CAN.h
+/**
+ * @file CAN.h
+ * @brief Host stand-in for the arduino-CAN library, used by the bus simulation only
+ *
+ * The simulator delivers received frames by calling the registered callback, like the
+ * receive interrupt would. Frames finished with endPacket() go to the transmit hook, which
+ * hands them to the bus model and reports whether the transmit FIFO accepted them.
+ */
+
+#ifndef HOST_SHIM_CAN_H
+#define HOST_SHIM_CAN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include "CanBus.h"
+
+namespace tronshim
+{
+struct ShimBus
+{
+    void (*callback)(int) = nullptr;
+    CanFrame rx = {};
+    uint8_t rxPos = 0;
+    CanFrame pending = {};
+    bool packetOpen = false;
+    std::function<bool(const CanFrame &frame)> transmit; // Set by the simulator
+
+    // Calls the receive callback of the firmware
+    void deliver(const CanFrame &frame)
+    {
+        rx = frame;
+        rxPos = 0;
+        if (callback)
+            callback(frame.dlc);
+    }
+};
+
+ShimBus &shimBus();
+} // namespace tronshim
+
+class CANClass
+{
+public:
+    int begin(long) { return 1; }
+    void end() {}
+
+    void onReceive(void (*callback)(int)) { tronshim::shimBus().callback = callback; }
+
+    long packetId() { return tronshim::shimBus().rx.id; }
+    int packetDlc() { return tronshim::shimBus().rx.dlc; }
+
+    int available()
+    {
+        tronshim::ShimBus &bus = tronshim::shimBus();
+        return bus.rx.dlc - bus.rxPos;
+    }
+
+    int read()
+    {
+        tronshim::ShimBus &bus = tronshim::shimBus();
+        return bus.rxPos < bus.rx.dlc ? bus.rx.data[bus.rxPos++] : -1;
+    }
+
+    size_t readBytes(uint8_t *buffer, size_t length)
+    {
+        size_t n = 0;
+        int c;
+        while (n < length && (c = read()) >= 0)
+            buffer[n++] = (uint8_t)c;
+        return n;
+    }
+
+    int beginPacket(int id, int = -1, bool = false)
+    {
+        tronshim::ShimBus &bus = tronshim::shimBus();
+        bus.pending = CanFrame{(uint16_t)id, 0, {0}};
+        bus.packetOpen = true;
+        return 1;
+    }
+
+    size_t write(uint8_t byte) { return write(&byte, 1); }
+
+    size_t write(const uint8_t *buffer, size_t size)
+    {
+        tronshim::ShimBus &bus = tronshim::shimBus();
+        size_t n = 0;
+        while (bus.packetOpen && n < size && bus.pending.dlc < 8)
+            bus.pending.data[bus.pending.dlc++] = buffer[n++];
+        return n;
+    }
+
+    int endPacket()
+    {
+        tronshim::ShimBus &bus = tronshim::shimBus();
+        if (!bus.packetOpen)
+            return 0;
+        bus.packetOpen = false;
+        return bus.transmit && bus.transmit(bus.pending) ? 1 : 0;
+    }
+};
+
+extern CANClass CAN;
+
+#endif
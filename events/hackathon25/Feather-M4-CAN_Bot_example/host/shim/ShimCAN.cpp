@@ -0,0 +1,22 @@
+// Feather-m4-can_bot_example/host/shim/ShimCAN.cpp
+/**
+ * @file ShimCAN.cpp
+ * @brief Globals of the host Arduino and CAN stand-ins
+ */
+
+#include "Arduino.h"
+#include "CAN.h"
+
+HardwareSerial Serial;
+CANClass CAN;
+
+namespace tronshim
+{
+uint64_t nowNs = 0;
+
+ShimBus &shimBus()
+{
+    static ShimBus instance;
+    return instance;
+}
+} // namespace tronshim
@@ -0,0 +1,331 @@
+// Feather-m4-can_bot_example/host/tuner.cpp
+/**
+ * @file tuner.cpp
+ * @brief Self-play SPSA tuner for the evaluation weights
+ *
+ * Simultaneous perturbation stochastic approximation: every iteration perturbs the tuned weights
+ * at once by +-c (random sign per weight), plays a batch of games with both the plus and the
+ * minus candidate, and steps along the estimated gradient of its points advantage. Both
+ * candidates play the same seeds, seats and opponents, so most of the game noise cancels out.
+ * Games are spread over all cores with the work-stealing pool.
+ *
+ * Only the weights that rank free moves against each other are tuned: distance, wall_bonus and
+ * straight_bonus. The ranking depends on their ratios to space alone, so space stays fixed as the
+ * unit. The reversal and collision penalties and the survival threshold are sentinels far below
+ * any free move and never change a decision, so they are left out as well. A perturbation of c
+ * is worth about one cell of area, which is what it takes to flip a decision.
+ *
+ * Copies of one deterministic policy on translated spawns mostly replay the same game, so the
+ * opponents are drawn per game: the start weights, randomly jittered start weights and the
+ * flood fill, open space and random bots of BasicStrategies.h. Every game also opens with a
+ * random number of random safe moves.
+ *
+ * At the end the tuned and the start weights play the same fresh games, and the difference of
+ * their advantages is reported. Only a result that beats the start weights is written as the
+ * constexpr header that the firmware build includes; otherwise the header is left alone and
+ * the tuner exits with status 1 (--force 1 writes it anyway).
+ *
+ *   pio run -e native_tuner && .pio/build/native_tuner/program --iterations 200
+ *
+ * Options:
+ *   --iterations N   SPSA iterations (default 100)
+ *   --games N        games per candidate and iteration, rounded up to a multiple of 4 (default 64)
+ *   --validate N     validation games of the result against the start weights (default 2000)
+ *   --opening N      up to this many random moves at the start of a game (default 24)
+ *   --threads N      worker threads (default: all hardware threads)
+ *   --seed S         seed of perturbations and games (default 1)
+ *   --output PATH    generated header (default include/TunedWeights.h)
+ *   --force 1        write the header even if the result does not beat the start weights
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BasicStrategies.h"
+#include "TronSim.h"
+#include "TunedWeights.h"
+#include "WorkStealingPool.h"
+
+namespace
+{
+struct Options
+{
+    unsigned iterations = 100;
+    unsigned games = 64;
+    unsigned validate = 2000;
+    unsigned opening = 24;
+    bool force = false;
+    unsigned threads = 0;
+    uint32_t seed = 1;
+    std::string output = "include/TunedWeights.h";
+};
+
+const char *const WEIGHT_NAMES[EVAL_WEIGHT_COUNT] = {"space",          "distance",         "wall_bonus",
+                                                      "straight_bonus", "reversal_penalty", "collision_penalty",
+                                                      "survival_threshold"};
+
+// Weights the optimizer changes, as indices into EvalWeights
+const int TUNED_COUNT = 3;
+const int TUNED_INDEX[TUNED_COUNT] = {1, 2, 3}; // distance, wall_bonus, straight_bonus
+
+// Change of each tuned weight that is worth about one cell of area at space = 10. The nearest
+// opponent distance differs by at most 2 between our targets, hence half a cell for distance.
+const float WEIGHT_SCALES[TUNED_COUNT] = {5.0f, 10.0f, 10.0f};
+
+// SPSA gains in units of WEIGHT_SCALES: a_k = A / (k + 1 + STABILITY)^0.602, c_k = C / (k + 1)^0.101
+const double GAIN_A = 1.0;
+const double GAIN_C = 1.0;
+const double STABILITY = 10.0;
+
+void toArray(const EvalWeights &weights, float values[EVAL_WEIGHT_COUNT])
+{
+    memcpy(values, &weights, sizeof(EvalWeights));
+}
+
+EvalWeights fromArray(const float values[EVAL_WEIGHT_COUNT])
+{
+    EvalWeights weights;
+    memcpy(&weights, values, sizeof(EvalWeights));
+    return weights;
+}
+
+/**
+ * Full weight set with the tuned weights replaced
+ */
+EvalWeights withTuned(const EvalWeights &base, const float tuned[TUNED_COUNT])
+{
+    float values[EVAL_WEIGHT_COUNT];
+    toArray(base, values);
+    for (int i = 0; i < TUNED_COUNT; i++)
+        values[TUNED_INDEX[i]] = tuned[i];
+    return fromArray(values);
+}
+
+uint32_t nextRandom(uint32_t &rng)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+/**
+ * One opponent of the candidate, drawn from the start weights, jittered start weights and the
+ * basic strategies
+ */
+SimPolicy opponentPolicy(const EvalWeights &baseline, uint32_t &rng)
+{
+    switch (nextRandom(rng) % 5)
+    {
+    case 0:
+        return weightedPolicy(baseline);
+    case 1:
+    {
+        float values[EVAL_WEIGHT_COUNT];
+        toArray(baseline, values);
+        float tuned[TUNED_COUNT];
+        for (int i = 0; i < TUNED_COUNT; i++)
+            tuned[i] = values[TUNED_INDEX[i]] + WEIGHT_SCALES[i] * ((nextRandom(rng) % 2001) / 1000.0f - 1.0f);
+        return weightedPolicy(withTuned(baseline, tuned));
+    }
+    case 2:
+        return strategyPolicy<FloodFillStrategy>();
+    case 3:
+        return strategyPolicy<OpenSpaceStrategy>();
+    default:
+        return strategyPolicy<RandomStrategy>();
+    }
+}
+
+/**
+ * Average points of the candidate minus the average points of its three opponents in the same
+ * games (0 means equal strength). Game g uses seed firstSeed + g, which also picks the opening
+ * and the opponents, and puts the candidate on seat g % 4.
+ */
+double matchCandidate(WorkStealingPool &pool, const EvalWeights &candidate, const EvalWeights &baseline,
+                      const Options &options, unsigned games, uint32_t firstSeed)
+{
+    std::vector<int> advantage(games);
+    WorkStealingPool::TaskGroup group;
+    for (unsigned g = 0; g < games; g++)
+    {
+        pool.run(group, [&, g] {
+            uint32_t rng = (firstSeed + g) * 2654435761u | 1;
+            SimPolicy policies[NUM_PLAYERS];
+            for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+                policies[i] = i == g % NUM_PLAYERS ? weightedPolicy(candidate) : opponentPolicy(baseline, rng);
+            SimOptions simOptions;
+            simOptions.seed = firstSeed + g;
+            simOptions.maxOpeningTicks = (uint8_t)options.opening;
+            SimGameResult result = playGame(policies, simOptions);
+            int others = 0;
+            for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+                others += i == g % NUM_PLAYERS ? 0 : result.points[i];
+            // In thirds of a point, to stay in integers
+            advantage[g] = 3 * result.points[g % NUM_PLAYERS] - others;
+        });
+    }
+    pool.wait(group);
+
+    int total = 0;
+    for (int a : advantage)
+        total += a;
+    return total / 3.0 / games;
+}
+
+bool writeHeader(const Options &options, const EvalWeights &weights, double validation)
+{
+    FILE *file = fopen(options.output.c_str(), "w");
+    if (!file)
+    {
+        fprintf(stderr, "Cannot write %s\n", options.output.c_str());
+        return false;
+    }
+
+    float values[EVAL_WEIGHT_COUNT];
+    toArray(weights, values);
+    fprintf(file, "// Feather-m4-can_bot_example/include/TunedWeights.h\n");
+    fprintf(file, "// Generated by host/tuner.cpp - do not edit by hand, rerun the tuner instead.\n");
+    fprintf(file, "// SPSA: %u iterations x %u games, seed %u, mixed opponents. Validation: %+.3f points\n",
+            options.iterations, options.games, (unsigned)options.seed, validation);
+    fprintf(file, "// per game more than the previous weights in %u games against the same opponents.\n",
+            options.validate);
+    fprintf(file, "// Only distance, wall_bonus and straight_bonus are tuned, the others are fixed.\n");
+    fprintf(file, "\n#ifndef TUNED_WEIGHTS_H\n#define TUNED_WEIGHTS_H\n\n#include \"EvalWeights.h\"\n\n");
+    fprintf(file, "constexpr EvalWeights TUNED_WEIGHTS = {\n");
+    for (int i = 0; i < EVAL_WEIGHT_COUNT; i++)
+    {
+        char number[32];
+        snprintf(number, sizeof(number), "%.6gf,", values[i]);
+        // %g drops the decimal point for whole numbers, which would make "10f" invalid
+        if (!strpbrk(number, ".e"))
+            snprintf(number, sizeof(number), "%.1ff,", values[i]);
+        fprintf(file, "    %-10s // %s\n", number, WEIGHT_NAMES[i]);
+    }
+    fprintf(file, "};\n\n#endif\n");
+    fclose(file);
+    return true;
+}
+
+bool parseOptions(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        unsigned value = (unsigned)strtoul(argv[i + 1], nullptr, 0);
+        if (!strcmp(argv[i], "--iterations"))
+            options.iterations = value;
+        else if (!strcmp(argv[i], "--games"))
+            options.games = (value + NUM_PLAYERS - 1) / NUM_PLAYERS * NUM_PLAYERS;
+        else if (!strcmp(argv[i], "--validate"))
+            options.validate = (value + NUM_PLAYERS - 1) / NUM_PLAYERS * NUM_PLAYERS;
+        else if (!strcmp(argv[i], "--opening"))
+            options.opening = value < 255 ? value : 255;
+        else if (!strcmp(argv[i], "--threads"))
+            options.threads = value;
+        else if (!strcmp(argv[i], "--seed"))
+            options.seed = value;
+        else if (!strcmp(argv[i], "--output"))
+            options.output = argv[i + 1];
+        else if (!strcmp(argv[i], "--force"))
+            options.force = value != 0;
+        else
+        {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return false;
+        }
+    }
+    if (argc % 2 == 0)
+    {
+        fprintf(stderr, "Missing value for %s\n", argv[argc - 1]);
+        return false;
+    }
+    return options.games > 0 && options.validate > 0;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+        return 2;
+    if (!options.threads)
+        options.threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+
+    WorkStealingPool pool(options.threads);
+    uint32_t rng = options.seed ? options.seed : 1;
+
+    // Start from the current header, so repeated runs continue where the last one stopped
+    const EvalWeights baseline = TUNED_WEIGHTS;
+    float start[EVAL_WEIGHT_COUNT];
+    toArray(baseline, start);
+    float theta[TUNED_COUNT];
+    for (int i = 0; i < TUNED_COUNT; i++)
+        theta[i] = start[TUNED_INDEX[i]];
+
+    printf("SPSA: %u iterations, %u games per candidate, %u threads\n", options.iterations, options.games,
+           options.threads);
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (unsigned k = 0; k < options.iterations; k++)
+    {
+        double a = GAIN_A / pow(k + 1 + STABILITY, 0.602);
+        double c = GAIN_C / pow(k + 1, 0.101);
+
+        float plus[TUNED_COUNT], minus[TUNED_COUNT];
+        int delta[TUNED_COUNT];
+        for (int i = 0; i < TUNED_COUNT; i++)
+        {
+            delta[i] = (nextRandom(rng) & 1) ? 1 : -1;
+            plus[i] = theta[i] + (float)(c * WEIGHT_SCALES[i] * delta[i]);
+            minus[i] = theta[i] - (float)(c * WEIGHT_SCALES[i] * delta[i]);
+        }
+
+        // Common random numbers: both candidates play the same openings, seats and opponents
+        uint32_t gameSeed = nextRandom(rng);
+        double scorePlus = matchCandidate(pool, withTuned(baseline, plus), baseline, options, options.games, gameSeed);
+        double scoreMinus =
+            matchCandidate(pool, withTuned(baseline, minus), baseline, options, options.games, gameSeed);
+
+        double step = a * (scorePlus - scoreMinus) / (2.0 * c);
+        for (int i = 0; i < TUNED_COUNT; i++)
+            theta[i] += (float)(step * delta[i] * WEIGHT_SCALES[i]);
+
+        if (k % 10 == 9 || k + 1 == options.iterations)
+        {
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+            printf("iteration %4u  plus %+.3f  minus %+.3f  %.1f s\n", k + 1, scorePlus, scoreMinus,
+                   elapsed.count());
+        }
+    }
+
+    EvalWeights tuned = withTuned(baseline, theta);
+    uint32_t validationSeed = nextRandom(rng);
+    double tunedScore = matchCandidate(pool, tuned, baseline, options, options.validate, validationSeed);
+    double startScore = matchCandidate(pool, baseline, baseline, options, options.validate, validationSeed);
+    double validation = tunedScore - startScore;
+
+    printf("\n%-20s %12s %12s\n", "weight", "start", "tuned");
+    float after[EVAL_WEIGHT_COUNT];
+    toArray(tuned, after);
+    for (int i = 0; i < EVAL_WEIGHT_COUNT; i++)
+        printf("%-20s %12.4f %12.4f\n", WEIGHT_NAMES[i], start[i], after[i]);
+    printf("\nValidation in %u games: advantage over the opponents %+.3f tuned, %+.3f start, difference %+.3f\n",
+           options.validate, tunedScore, startScore, validation);
+
+    if (validation <= 0.0 && !options.force)
+    {
+        printf("Not better than the start weights, %s left unchanged (--force 1 writes it anyway)\n",
+               options.output.c_str());
+        return 1;
+    }
+    if (!writeHeader(options, tuned, validation))
+        return 1;
+    printf("Wrote %s\n", options.output.c_str());
+    return 0;
+}
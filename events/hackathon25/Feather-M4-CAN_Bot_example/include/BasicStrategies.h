@@ -0,0 +1,52 @@
+// Feather-m4-can_bot_example/include/BasicStrategies.h
+/**
+ * @file BasicStrategies.h
+ * @brief The earlier bots of the team as strategies on the shared game loop
+ *
+ * Each one reproduces the decision rule of a stand-alone sketch, without its copy of the CAN
+ * handling and the grid globals:
+ * - FloodFillStrategy (Game_logic_new_cpp.txt): largest accessible area, x10, plus x2 per
+ *   occupied neighbour of the target cell
+ * - RandomStrategy (adam_kack.txt): a random forward move that does not crash at once
+ * - OpenSpaceStrategy (../figures/n_test_main.cpp): heads for the free cell with the most free
+ *   neighbours along a shortest path
+ *
+ * They serve as baselines next to TunedStrategy, e.g. in the bus simulation environments.
+ */
+
+#ifndef BASIC_STRATEGIES_H
+#define BASIC_STRATEGIES_H
+
+#include "Strategy.h"
+
+class FloodFillStrategy : public StrategyBase
+{
+public:
+    static const char *name() { return "floodfill"; }
+
+    uint8_t decide(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], const uint8_t headings[NUM_PLAYERS],
+                   uint8_t me);
+};
+
+class RandomStrategy : public StrategyBase
+{
+public:
+    static const char *name() { return "random"; }
+
+    uint8_t decide(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], const uint8_t headings[NUM_PLAYERS],
+                   uint8_t me);
+
+private:
+    uint32_t rng_ = 0x2545F491u;
+};
+
+class OpenSpaceStrategy : public StrategyBase
+{
+public:
+    static const char *name() { return "openspace"; }
+
+    uint8_t decide(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], const uint8_t headings[NUM_PLAYERS],
+                   uint8_t me);
+};
+
+#endif
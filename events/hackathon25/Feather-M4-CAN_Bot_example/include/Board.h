@@ -0,0 +1,102 @@
+// Feather-m4-can_bot_example/include/Board.h
+/**
+ * @file Board.h
+ * @brief Compact game position with make/unmake of simultaneous moves for tree search
+ *
+ * Where TronState is copied for every child (4 KB), a Board is changed in place and restored:
+ * - Occupancy is one bitboard for all living traces plus one per player, 2.5 KB in total
+ * - Each player's trail stack holds the head at init() and every cell entered since, so
+ *   unmake() pops the head back
+ * - The undo stack keeps what a tick overwrites: headings, alive mask, the deaths and the hash
+ *
+ * make() follows applyMoves(): all players move at once against the old occupancy, the
+ * players that hit a trace or each other die, and only then their traces disappear. A dead
+ * player's bitboard is kept, so removing and restoring its trace are 64 word operations each,
+ * independent of the trace length. The hash equals TronState::hash of the same position.
+ */
+
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <stdint.h>
+#include "TronCore.h"
+
+// Ticks that can be made on top of init() before they have to be unmade
+#ifndef BOARD_MAX_PLIES
+#define BOARD_MAX_PLIES 64
+#endif
+
+class Board
+{
+public:
+    /**
+     * Loads a position; drops all undo information
+     */
+    void init(const TronState &state);
+
+    /**
+     * Advances the position by one tick. Invalid or backwards moves keep the heading.
+     * At most BOARD_MAX_PLIES ticks can be made without unmaking.
+     *
+     * @param moves Requested direction per player (DIR_NONE keeps the heading)
+     * @return Bit mask of the players that died in this tick
+     */
+    uint8_t make(const uint8_t moves[NUM_PLAYERS]);
+
+    /**
+     * Takes back the last make()
+     */
+    void unmake();
+
+    /**
+     * Writes the position as a TronState, e.g. to hand it to the flood fill
+     */
+    void toState(TronState &state) const;
+
+    bool isFree(uint8_t x, uint8_t y) const { return !((occupied_[x] >> y) & 1); }
+
+    /**
+     * @return Occupancy of column x, bit y set if cell (x, y) is covered by a living trace
+     */
+    uint64_t column(uint8_t x) const { return occupied_[x]; }
+
+    /**
+     * @return 1-based ID of the living player whose trace covers the cell, 0 if it is free
+     */
+    uint8_t owner(uint8_t x, uint8_t y) const;
+
+    uint8_t x(uint8_t player) const { return x_[player]; }
+    uint8_t y(uint8_t player) const { return y_[player]; }
+    uint8_t heading(uint8_t player) const { return heading_[player]; }
+    uint8_t alive() const { return alive_; }
+    uint64_t hash() const { return hash_; }
+    uint16_t ply() const { return ply_; }
+
+private:
+    struct Undo
+    {
+        uint64_t hash;
+        uint8_t heading[NUM_PLAYERS];
+        uint8_t alive;
+        uint8_t died;  // Players that died in this tick
+        uint8_t moved; // Players that pushed a cell onto their trail
+    };
+
+    void setCell(uint8_t player, uint16_t cell);
+    void clearCell(uint8_t player, uint16_t cell);
+
+    uint64_t occupied_[GRID_WIDTH];                // Bit y of word x: cell covered by a living trace
+    uint64_t trace_[NUM_PLAYERS][GRID_WIDTH];      // Cells of each player's trace, kept after death
+    uint64_t traceHash_[NUM_PLAYERS];              // XOR of the Zobrist keys of each trace
+    uint16_t trail_[NUM_PLAYERS][BOARD_MAX_PLIES + 1]; // Head at init() and the cells entered since
+    uint16_t trailLength_[NUM_PLAYERS];
+    Undo undo_[BOARD_MAX_PLIES];
+    uint64_t hash_;
+    uint8_t x_[NUM_PLAYERS];
+    uint8_t y_[NUM_PLAYERS];
+    uint8_t heading_[NUM_PLAYERS];
+    uint8_t alive_;
+    uint16_t ply_;
+};
+
+#endif
@@ -0,0 +1,89 @@
+// Feather-m4-can_bot_example/include/EndgameSolver.h
+/**
+ * @file EndgameSolver.h
+ * @brief Exact longest path when our head is sealed in a small pocket
+ *
+ * Once no opponent head borders the free cells we can reach, nothing but our own moves
+ * changes that region, and the best move is the first step of the longest simple path
+ * through it. The flood fill evaluation only compares region sizes and often strands cells
+ * there. For regions of at most ENDGAME_MAX_CELLS cells the solver finds the exact path by a
+ * depth-first search over a 64-bit cell mask, with the cells ahead ordered by their free
+ * neighbours (Warnsdorff) and two bounds: the cells still reachable, and their checkerboard
+ * colours, since a path alternates colours.
+ *
+ * Solved pockets go into a fixed-size cache keyed by the region shape relative to its bounding
+ * box plus the entry cell, so a shape is solved once for any position on the torus. Every
+ * suffix of the optimal path is optimal for the pocket that is left, so those pockets are
+ * cached as well and the following ticks of the same pocket are lookups. The cache lives
+ * across games. Like the transposition table it verifies entries on every probe, because the
+ * CAN callback and speculation in loop() share it.
+ */
+
+#ifndef ENDGAME_SOLVER_H
+#define ENDGAME_SOLVER_H
+
+#include <stdint.h>
+#include "TronCore.h"
+
+// Largest pocket that is solved exactly, 0 disables the solver. At most 62, so that a
+// pocket cannot wrap around the 64-cell grid and its shape is a plain translation.
+#ifndef ENDGAME_MAX_CELLS
+#define ENDGAME_MAX_CELLS 32
+#endif
+
+// Search nodes per solve; beyond that the best path found so far is played (and not cached)
+#ifndef ENDGAME_NODE_LIMIT
+#define ENDGAME_NODE_LIMIT 4000
+#endif
+
+// Cache slots (16 bytes each), a power of two
+#ifndef ENDGAME_CACHE_SLOTS
+#define ENDGAME_CACHE_SLOTS 256
+#endif
+
+static_assert(ENDGAME_MAX_CELLS <= 62, "Pockets must be smaller than a grid row");
+static_assert(ENDGAME_NODE_LIMIT > 0, "The solver needs at least one node");
+static_assert((ENDGAME_CACHE_SLOTS & (ENDGAME_CACHE_SLOTS - 1)) == 0, "ENDGAME_CACHE_SLOTS must be a power of two");
+
+struct EndgameResult
+{
+    uint8_t direction; // First step of the path
+    uint8_t length;    // Moves until we are stuck
+    uint8_t cells;     // Free cells in the pocket
+    bool exact;        // false if the node limit stopped the search
+    bool cached;       // Answered from the cache
+};
+
+struct EndgameStats
+{
+    uint32_t sealed;  // Decisions inside a pocket small enough to solve
+    uint32_t hits;    // ...answered from the cache
+    uint32_t solved;  // ...searched to the end
+    uint32_t aborted; // ...stopped by the node limit
+    uint32_t nodes;   // Search nodes of all solves
+};
+
+/**
+ * Solves our move if we are sealed in a pocket of at most ENDGAME_MAX_CELLS free cells.
+ *
+ * @param grid Current grid including all heads
+ * @param heads Head positions, NO_POSITION for dead players
+ * @param me Our player index (player ID - 1)
+ * @param result Move and path length, only written when the solver applies
+ * @return false if an opponent can still enter the region or it is too large
+ */
+bool solveEndgame(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], uint8_t me, EndgameResult &result);
+
+/**
+ * @return Counters since the last endgameResetStats()
+ */
+const EndgameStats &endgameStats();
+
+void endgameResetStats();
+
+/**
+ * Empties the cache, e.g. to measure cold solves
+ */
+void endgameClearCache();
+
+#endif
@@ -0,0 +1,33 @@
+// Feather-m4-can_bot_example/include/EvalWeights.h
+/**
+ * @file EvalWeights.h
+ * @brief Weights of the move evaluation described in Tactic.md
+ *
+ * The values used by the firmware live in the generated TunedWeights.h.
+ */
+
+#ifndef EVAL_WEIGHTS_H
+#define EVAL_WEIGHTS_H
+
+/**
+ * Scoring weights of evaluateMove
+ */
+struct EvalWeights
+{
+    float space;              // Per cell accessible from the target cell
+    float distance;           // Per cell of distance from the target to the nearest opponent head
+    float wall_bonus;         // If a neighbour of the target other than our head is blocked
+    float straight_bonus;     // For keeping the current heading
+    float reversal_penalty;   // For a 180 degree turn (the server ignores it)
+    float collision_penalty;  // For moving into an occupied cell
+    float survival_threshold; // Below this best score, take any move that survives the next tick
+};
+
+const int EVAL_WEIGHT_COUNT = 7;
+
+/**
+ * Hand-written weights from Tactic.md, the starting point of the tuner
+ */
+constexpr EvalWeights TACTIC_WEIGHTS = {10.0f, 0.5f, 5.0f, 5.0f, -2000.0f, -1000.0f, -500.0f};
+
+#endif
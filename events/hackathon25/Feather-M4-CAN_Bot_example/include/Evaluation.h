@@ -0,0 +1,45 @@
+// Feather-m4-can_bot_example/include/Evaluation.h
+/**
+ * @file Evaluation.h
+ * @brief One-ply move evaluation from Tactic.md
+ *
+ * Defines:
+ * - The weighted score of a single candidate move
+ * - Move selection including the survival mode fallback
+ *
+ * Works on an explicit grid instead of the firmware globals, so the tuner can play many
+ * games in parallel with the same code the firmware runs.
+ */
+
+#ifndef EVALUATION_H
+#define EVALUATION_H
+
+#include <stdint.h>
+#include "EvalWeights.h"
+#include "TronCore.h"
+
+/**
+ * Evaluates a move based on collision avoidance, accessible area, opponent distance,
+ * neighbouring walls and the current heading.
+ *
+ * @param grid Current grid, any non-zero cell is blocked
+ * @param heads Head positions of all players, NO_POSITION for dead ones
+ * @param me Our player index (player ID - 1)
+ * @param heading Direction of our last step
+ * @param direction Direction to evaluate (1=UP, 2=RIGHT, 3=DOWN, 4=LEFT)
+ * @param weights Scoring weights
+ * @return Score for the move
+ */
+float evaluateMove(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], uint8_t me, uint8_t heading,
+                   uint8_t direction, const EvalWeights &weights);
+
+/**
+ * Picks the best scoring direction. If even that one scores below the survival threshold,
+ * any direction that does not crash in the next tick is taken instead.
+ *
+ * @return Chosen direction (1-4)
+ */
+uint8_t chooseMove(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], uint8_t me, uint8_t heading,
+                   const EvalWeights &weights);
+
+#endif
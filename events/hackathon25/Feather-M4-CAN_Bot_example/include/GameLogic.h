@@ -4,10 +4,10 @@
  * @brief Game strategy and decision-making logic for Tron game
  *
  * Defines:
- * - Position structure for path planning
- * - Algorithm helper functions
  * - Game message processing functions
- * - Grid and player trace storage
+ * - The idle hook for loop()
+ *
+ * All of them forward to one GameLoop (GameLoop.h) instantiated with the strategy of the build.
  */
 
 #ifndef GAME_LOGIC_H
@@ -22,5 +22,18 @@ void process_Die(uint8_t *data);
 void process_GameFinish(uint8_t *data);
 void process_Error(uint8_t *data);
 
+/**
+ * @return Name of the strategy this build plays (TRON_STRATEGY)
+ */
+const char *strategyName();
+
+/**
+ * Gives the strategy the idle time between messages, e.g. to precompute our move for a
+ * likely next GameState; call from loop()
+ *
+ * @return false if there was nothing left to do
+ */
+bool speculateNextMove();
+
 
 #endif
\ No newline at end of file
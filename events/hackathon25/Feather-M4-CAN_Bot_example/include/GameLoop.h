@@ -0,0 +1,165 @@
+// Feather-m4-can_bot_example/include/GameLoop.h
+/**
+ * @file GameLoop.h
+ * @brief Protocol handling and board bookkeeping shared by all strategies
+ *
+ * GameLoop turns the server messages into the board every strategy works on: the grid with
+ * all traces, the trace of every player (to clear it when the player dies) and every player's
+ * last step direction. It sends the move that its Strategy (Strategy.h) decides, prints the
+ * points on GameFinish and rejoins. The strategy is a template parameter, so the calls into it
+ * are direct and can be inlined.
+ */
+
+#ifndef GAME_LOOP_H
+#define GAME_LOOP_H
+
+#include <cstring>
+#include "CANHandler.h"
+#include "MemoryWatch.h"
+#include "Profiler.h"
+#include "Strategy.h"
+
+template <typename Strategy> class GameLoop
+{
+public:
+    GameLoop() { reset(); }
+
+    /**
+     * Updates the board from a GameState and sends our move
+     *
+     * @param data Head positions of players 1-4 as x, y pairs
+     */
+    void gameState(const uint8_t *data)
+    {
+        PROFILE_ZONE(ZONE_GAME_STATE);
+
+        uint8_t heads[NUM_PLAYERS][2];
+        for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+        {
+            heads[i][0] = data[2 * i];
+            heads[i][1] = data[2 * i + 1];
+        }
+
+        // The first GameState of a game shows the spawn points
+        bool first_state = true;
+        for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+            first_state = first_state && traces_[i].empty();
+
+        // Update grid: traces stay until their player dies
+        uint8_t steps[NUM_PLAYERS] = {DIR_NONE, DIR_NONE, DIR_NONE, DIR_NONE};
+        bool moved = false;
+        for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+        {
+            uint8_t x = heads[i][0];
+            uint8_t y = heads[i][1];
+            if (x == NO_POSITION || y == NO_POSITION)
+                continue;
+
+            if (!traces_[i].empty())
+            {
+                const std::pair<uint8_t, uint8_t> &last = traces_[i].back();
+                if (last.first == x && last.second == y)
+                    continue; // Repeated GameState, nothing moved
+                steps[i] = directionBetween(last.first, last.second, x, y);
+                if (steps[i] != DIR_NONE)
+                    headings_[i] = steps[i];
+            }
+            grid_[x][y] = i + 1;
+            traces_[i].push_back({x, y});
+            moved = true;
+        }
+
+        uint8_t me = player_ID - 1;
+        if (first_state)
+            strategy_.start(grid_, heads, me);
+        else if (moved)
+            strategy_.step(grid_, heads, steps, me);
+
+        uint8_t direction = strategy_.decide(grid_, heads, headings_, me);
+        if (direction > 0)
+        {
+            send_Move(direction);
+            strategy_.moveSent(grid_, heads, headings_, me, direction);
+        }
+
+        MEMWATCH_TICK();
+    }
+
+    /**
+     * Removes the trace of a dead player
+     *
+     * @param data ID of the dead player
+     */
+    void die(const uint8_t *data)
+    {
+        uint8_t dead_player_id = data[0];
+        Serial.printf("Player %u died\n", dead_player_id);
+
+        if (dead_player_id == player_ID)
+        {
+            Serial.println("You died! Game over.");
+            is_dead = true;
+        }
+
+        if (dead_player_id >= 1 && dead_player_id <= NUM_PLAYERS)
+        {
+            Trace &trace = traces_[dead_player_id - 1];
+            for (const auto &cell : trace)
+            {
+                grid_[cell.first][cell.second] = 0; // Free up the grid cell
+                Serial.printf("Cleared trace at (%u, %u) for Player %u\n", cell.first, cell.second, dead_player_id);
+            }
+            strategy_.released(grid_, dead_player_id - 1, trace);
+            trace.clear();
+        }
+    }
+
+    /**
+     * Prints the points and statistics, resets the board and rejoins
+     *
+     * @param data Player ID and points of players 1-4
+     */
+    void gameFinish(const uint8_t *data)
+    {
+        Serial.println("Game finished. Points distribution:");
+        for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+            Serial.printf("Player %u: %u points\n", data[i * 2], data[i * 2 + 1]);
+
+        strategy_.finish();
+        PROFILE_REPORT();
+        MEMWATCH_REPORT();
+
+        // Reset all game state for next game
+        is_dead = false;
+        reset();
+
+        // Auto-rejoin for next game
+        Serial.println("Rejoining the game...");
+        send_Join();
+    }
+
+    /**
+     * Gives the strategy the idle time of loop()
+     *
+     * @return false if there was nothing to do
+     */
+    bool idle() { return !is_dead && strategy_.idle(); }
+
+private:
+    void reset()
+    {
+        memset(grid_, 0, sizeof(grid_));
+        for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+        {
+            traces_[i].clear();
+            headings_[i] = DIR_UP;
+        }
+    }
+
+    Strategy strategy_;
+    Grid grid_;                    // 0 = free, otherwise ID of the player whose trace is there
+    Trace traces_[NUM_PLAYERS];    // Movement history of all players
+    uint8_t headings_[NUM_PLAYERS]; // Last step direction of every player
+};
+
+#endif
@@ -0,0 +1,78 @@
+// Feather-m4-can_bot_example/include/MemoryWatch.h
+/**
+ * @file MemoryWatch.h
+ * @brief Stack and heap high-water marks per game tick
+ *
+ * At startup a window of free stack below setup() is painted with a fixed pattern. After every
+ * GameState the lowest overwritten word gives the deepest stack use since the last tick
+ * (CAN callback and loop() together, the callback runs on the same stack). The used part of
+ * the window is then painted again. Heap use is read from mallinfo().
+ *
+ * On the M4 the stack grows down towards the heap. If the gap between the deepest stack use
+ * and the end of the heap falls below STACK_WARN_BYTES, a warning is printed. The per-game
+ * maxima are printed on GameFinish.
+ *
+ * Enabled with -DTRON_MEMWATCH in build_flags. Without it every macro expands to nothing.
+ * Host builds measure the same way; stack depths there are relative to the caller of setup().
+ */
+
+#ifndef MEMORY_WATCH_H
+#define MEMORY_WATCH_H
+
+#include <stdint.h>
+
+// Bytes of stack below setup() that are painted and scanned
+#ifndef STACK_WATCH_WINDOW
+#define STACK_WATCH_WINDOW 65536
+#endif
+
+// Warn if the stack comes closer than this to the heap (M4 only)
+#ifndef STACK_WARN_BYTES
+#define STACK_WARN_BYTES 4096
+#endif
+
+struct MemoryStats
+{
+    uint32_t stackPeak; // Deepest stack use in bytes
+    uint32_t heapInUse; // Allocated heap bytes after the tick
+    uint32_t heapArena; // Heap obtained from the system, the heap high-water mark
+    uint32_t minGap;    // Smallest distance between stack and heap (M4), 0 if unknown
+    uint16_t peakTick;  // Tick of stackPeak in the game
+    bool saturated;     // The stack reached the bottom of the painted window
+};
+
+#ifdef TRON_MEMWATCH
+
+/**
+ * Paints the stack window; call early in setup()
+ */
+void memoryWatchInit();
+
+/**
+ * Measures the tick that just ended, warns close to overflow and paints the window again
+ */
+void memoryWatchTick();
+
+/**
+ * @return Measurement of the last tick
+ */
+const MemoryStats &memoryWatchLastTick();
+
+/**
+ * Prints the maxima of the current game and starts a new one
+ */
+void memoryWatchReport();
+
+#define MEMWATCH_INIT() memoryWatchInit()
+#define MEMWATCH_TICK() memoryWatchTick()
+#define MEMWATCH_REPORT() memoryWatchReport()
+
+#else
+
+#define MEMWATCH_INIT() ((void)0)
+#define MEMWATCH_TICK() ((void)0)
+#define MEMWATCH_REPORT() ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,66 @@
+// Feather-m4-can_bot_example/include/MlpEval.h
+/**
+ * @file MlpEval.h
+ * @brief Learned move evaluation: a quantized two-layer perceptron over local board features
+ *
+ * Every free, forward move is described by MLP_INPUTS int8 features (see mlpFeatures()) and
+ * scored by a 16-unit ReLU network with int8 weights and int32 accumulators. The move with the
+ * highest score is played. Weights are generated by host/mlp_train.cpp, which trains the network
+ * to pick the moves of the game search, into the constexpr arrays of include/MlpWeights.h.
+ *
+ * On the Cortex-M4 the dot products use the DSP extension: SXTB16 widens two int8 weights to
+ * int16 lanes and SMLAD multiplies and accumulates both lanes in one cycle. Other builds run the
+ * same packed arithmetic with portable versions of the two instructions. mlpScoreReference() is
+ * the plain loop version; both must return identical scores.
+ *
+ * The territory feature needs a breadth-first search per move (12 KB of stack).
+ *
+ * Experimental: it does not beat chooseMove(). Against the current TUNED_WEIGHTS it agrees less
+ * often with the search than the heuristic does (96.9% against 97.9% held out), plays about
+ * even with it in native_mlp_bench (-0.11 points per game over 200 games, +0.04 over 400) and
+ * costs about 190 times as much per decision. -DMLP_EVAL=1 (with SEARCH_DEPTH 0) is there to
+ * measure it on the bus, not as the better evaluation. The weights must be retrained whenever
+ * Evaluation.cpp or TunedWeights.h change, since the labels break ties with them.
+ */
+
+#ifndef MLP_EVAL_H
+#define MLP_EVAL_H
+
+#include <stdint.h>
+#include "TronCore.h"
+
+const uint8_t MLP_WINDOW = 7;   // Side of the occupancy window around the target cell
+const uint8_t MLP_INPUTS = 56;  // Multiple of 4 for the packed dot product
+const uint8_t MLP_HIDDEN = 16;  // Multiple of 4 as well
+const int8_t MLP_ONE = 127;     // Feature value of "yes" and of saturated quantities
+
+/**
+ * Features of one move, all in [0, MLP_ONE]:
+ * - MLP_WINDOW x MLP_WINDOW occupancy around the target cell, rotated so that the move points up
+ * - accessible area from the target cell, in cells (saturating) and in units of 32 cells
+ * - cells we reach strictly before every opponent from the target cell, in units of 32 cells
+ * - distances from the target cell to the three opponent heads, nearest first, x2
+ * - going straight
+ *
+ * @param area Accessible area from the target cell, e.g. from compareAccessibleAreas()
+ */
+void mlpFeatures(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], uint8_t me, uint8_t heading,
+                 uint8_t direction, int area, int8_t features[MLP_INPUTS]);
+
+/**
+ * Network score of a feature vector, packed dual 16-bit multiply-accumulate
+ */
+int32_t mlpScore(const int8_t features[MLP_INPUTS]);
+
+/**
+ * Same score with plain loops, the reference for mlpScore()
+ */
+int32_t mlpScoreReference(const int8_t features[MLP_INPUTS]);
+
+/**
+ * Picks the free forward move with the highest network score; if every move is blocked, the
+ * first forward move
+ */
+uint8_t mlpChooseMove(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], uint8_t me, uint8_t heading);
+
+#endif
@@ -0,0 +1,125 @@
+// Feather-m4-can_bot_example/include/MlpWeights.h
+// Generated by host/mlp_train.cpp - do not edit by hand, rerun the trainer instead.
+// 20000 positions, search depth 3, 60 epochs, seed 1. Held-out agreement with the search:
+// network 96.9%, heuristic 97.9%.
+
+#ifndef MLP_WEIGHTS_H
+#define MLP_WEIGHTS_H
+
+#include "MlpEval.h"
+
+// Right shift of the first-layer accumulators before the ReLU clamp
+constexpr uint8_t MLP_SHIFT = 8;
+
+alignas(4) constexpr int8_t MLP_W1[MLP_HIDDEN][MLP_INPUTS] = {
+    {
+          10,  -3,  -5,  17,  -8,  -8,   4,   5,  -4, -42,  45,  -8, -19,  -6,
+         -13, -53, -88, 127,  -1,   0,   5,  -4, -98,  27, -17, -80,   8,  -2,
+           6, -50, -20,   9,  -9,  35,  20,  10, -10, -13,   9,  32,  -9,  24,
+          -2,   0, -15,  28,  33,  -2, -17,   8,   5,  -7, -27,  29, -14, -50,
+    },
+    {
+         -32,   0,  43, -26, -34,-127, -62,  27, -18,   3,  48, -25, -10,  39,
+         -43,   6,  36,  92, -39,  50,  -5,  -1,  42,-116,  13, -23, -37, -75,
+           7,   8, -13, -37,  35, -23, -81,  18,  16, -16,  -9,  23,   3,  32,
+           1,  13, -14,  -3,  17, -11,   2,  13, -22, -42,  13,  12,  12, -58,
+    },
+    {
+          10,  13,  -8,   3, -20,   1,  15,  36,   8,   1,  -8, -15,   8,  -6,
+           3,   7,  48, -97,  11,  -1,  13, -18, -21, -99,   4, -28, -36, -23,
+         -12, -15, -33, -37, -14, -12, -14,  13,  37,  51,  14,   4,  -5,  10,
+          -2,  14,   0,  34,  -5,   8, -14,   6,   1,   8, -13,  38,  25,  63,
+    },
+    {
+           1,   1,   4,  -1,  -7,  -2,  -6,   5,   5,   5,   6,  -5,  -2,   2,
+           2,   3,   1,   5,  -4,  -6,  -2,  -2,   3,   0,  -2,  -3,  -4,   0,
+           0,  -2,  -4,  -3,   1,  -3,  -4,   2,   0,  -2,   0,  -4,   2,   0,
+          -4,   5,   1,   3,   2,   2,  -6,  15,  14,   0, 127,   6,  -4,   1,
+    },
+    {
+         -20, -14,  10, -27,  16,  24,   0,   9,  -7, -25, -21, -17, -18,  14,
+         -34, -42, -24, -64, -11, -42,   1, -24,  -3, -17,   5, -39, -24, -16,
+           8, -11,  -1, -22,  -2,  13, -21,  15,  19,  54,   7,  37,  13, -12,
+           3, -12,  27,   8,  15,   1, -12,  12,   9,  20, -15,  25,  24,  57,
+    },
+    {
+           6,  -9, -19, -12,  -2,   4,  -8,   2,   4, -48,  21,   7,  29,  -7,
+         -16, -15, -18,  35,  27,  26,  22,   5,  16, -77,  15,  43,  21,  -1,
+          -8,  -2,  -6,   0,  -5, -13,  -5,   3,  20,   2,  18,  -4,  -7, -25,
+           1,   6,  10, -23, -20,  14,  -7,  36, -10,  20, 114, -53,  -7,  23,
+    },
+    {
+          -2,   3,   0,  -1,  -1,   1,  -2,   1,   2,  -1,   0,   1,  -1,  -1,
+          -2,  -2,   1,  -1,   0,   2,   0,   0,  -2,  -1,  -1,   1,   2,   1,
+          -1,   1,   0,   4,   0,  -1,  -1,  -1,   0,  -3,   2,   3,   0,   3,
+           2,   0,   2,   1,   2,   3,  -1,  15,  20,   2, 127,  14,   7,  -1,
+    },
+    {
+          21,   2,   3,  11, -11,  -4, -13,  10, -28, -26,  10, -20,  26,   3,
+          -3, -77, -55, -15,  42,  17,   7,  17,  -1, -30, -18, -89, -22,  -8,
+           0,  37,  -2,  12, -24,  -7,  -3,  -8,  15,  59,  23,  48,  -3, -11,
+          -2, -12,  17,  35, -24,   1,  -5, -13,  17,  16, -79,  43, -14,  61,
+    },
+    {
+         -11,   2,   4, -19,   0,  26,   0, -19,  19,   2,  22,   2, -22,   4,
+          -3,  15,  23,   4,  30,  -2, -20,  14,  -5,-100, -15, -73,  14,   4,
+          -9,  -4, -28,  -7,  -1,  12,  -9,  -7,  -2,  20,  41,  37,  13,   7,
+           2,  -4, -14,  22,  14,  17,   7,  -6,  19,   3, -44,  23,  -4,  53,
+    },
+    {
+           4,  -1, -41,  -1, -25, -12,  12,  11,   9,  21,  52, -61,  32,   9,
+           6, -22,  51, 104, -50, -31,  -7,  -8,  14, -94,  -4,-127,  -5,   1,
+          13,  29, -17, -27,  -1,   5,  13, -14,   8,  27,  36,  12, -12,   4,
+          -5,   2,  -5, -11, -21,  -3, -15,   2,  -5,  -1,  -3,  26,   6, -24,
+    },
+    {
+          -3,   1,  -8,  -2,  -1,  -1,   5,   7,  -2,  -2,  -1,   3,  -4,  -1,
+          -1,   1,   2,   0,   2,  -8,   5,   5,   8,   9,  -3,   5,   3,  -5,
+           0,  -5,  -5,   4,   3,   5,   2,  -1,   3,  -5,  -3,  -6,  -4,  -1,
+          -6,   2,  -7,  -2, -11,  -5,  -3,  18,   2,  14, 127, -11,  -4,   7,
+    },
+    {
+         -11,   8,   1, -22, -12,   4,   0, -10,  10,  31, -24,  -2,  11,   7,
+           6,  34,  48,-127,  -6, -10,  -1, -15, -52, -67,   4,   7,   7,   4,
+         -17, -13,   8,   0,  10,   3,  -4,  -7, -22,  -5,  -7,   7,  -3,   7,
+           6,   3,  -1,  -7,  17,  11,  -7,   3,  -1, -10, -27,  23,  -8,   1,
+    },
+    {
+          -3,  -3,   4,  -3,  -5,   3,  10,   4,   4,   5,  -4,  -3,   6,   8,
+           8,   8,  12,  -4,  10,  11,  -2,   8,   5,  -7,  -8,   4,  -1,  10,
+          -1,  17,   6,  30,  -4,  14,   3,  -2,  -1,   9,  19,   2,  11,   1,
+           6,  10,   7,  -3,  13,   6,   0, -17,   8,  -5,-124,  26,  19,  13,
+    },
+    {
+         -12, -12,   2,  16, -22,  -8,  13,  -1,   7,  30, -10, -41,   2,  16,
+           4,  -4,  -4, -18, -65, -18,  -4,  12,  19,  51, -11,-107,  11,  23,
+          -6,   3,  13,  26, -11, -11,   3, -11,  -3, -21,   5, -28,  -4, -10,
+         -11,   8,  -8,  14,   2,  -7,   6,  26,  -2,  -8, 117, -10, -26,  12,
+    },
+    {
+           1,  -1,   1,  -1,   0,   2,   1,  -1,   0,  -1,   1,  -1,   0,   1,
+           0,   0,  -1,   2,   1,   1,  -1,   0,   1,  -2,   0,   1,  -1,   0,
+           1,   1,   0,   4,  -1,   2,   0,  -1,   1,   2,   2,   0,   2,   0,
+           1,   0,   2,   0,   2,   1,   1,  25,  21,   6, 127,   1,   0,  -2,
+    },
+    {
+          -7,  -3,  17, -11, -14,  30, -11, -33,  25,  14,  -7,  -1,  -8,   3,
+         -33,  -5, -32,   9,   8, -46,  -8,  43,  49,  -8,   0,  70,  30,  -6,
+           3,  53,  16,   0,  11,  30, -23, -33,  21,  11, -28,   4,  19, -25,
+           8,  -7,  40,   2,   7,   6,  29, -46,   4,  46, -78,   6,  33, -39,
+    },
+};
+
+constexpr int32_t MLP_B1[MLP_HIDDEN] = {
+    555, -1532, -1835, -5, -497, 739, 444, 154,
+    1022, -561, 436, -642, 3192, 2209, 455, 2517,
+};
+
+alignas(4) constexpr int8_t MLP_W2[MLP_HIDDEN] = {
+      -4,  -3,  -2,  14,  -2,   2,  51,  -2,  -2,  -4,  14,  -4,  -5,   3,
+     127,  -2,
+};
+
+constexpr int32_t MLP_B2 = -1;
+
+#endif
@@ -0,0 +1,81 @@
+// Feather-m4-can_bot_example/include/OpeningBook.h
+/**
+ * @file OpeningBook.h
+ * @brief Precomputed moves for the first ticks of every game
+ *
+ * Every game starts from the same four spawn points heading UP. On the wrapping grid the spawns
+ * are translations of each other: the shift that moves player i onto player 1's spawn moves
+ * player j onto the spawn of player (j XOR i). So while nobody has died, a position is fully
+ * described by the step directions of all players since the start, listed from our point of
+ * view, and one book serves all four seats.
+ *
+ * The book key hashes that sequence tick by tick. host/book_gen.cpp searches the book positions
+ * offline and writes the sorted keys and moves to OpeningBookData.h, which stays in flash.
+ * The bot plays from the book until a position is not in it, then evaluates as usual.
+ */
+
+#ifndef OPENING_BOOK_H
+#define OPENING_BOOK_H
+
+#include <stdint.h>
+#include "TronCore.h"
+
+// Key of the start position (FNV-1a offset basis)
+const uint32_t OPENING_BOOK_ROOT = 2166136261u;
+
+/**
+ * Advances a book key by one tick (FNV-1a over one byte per tick)
+ *
+ * @param key Key of the position before the tick
+ * @param steps Step direction of every player, indexed by (player XOR me)
+ */
+inline uint32_t openingBookStep(uint32_t key, const uint8_t steps[NUM_PLAYERS])
+{
+    uint8_t code = 0;
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+        code |= (uint8_t)((steps[i] - 1) & 3) << (2 * i);
+    return (key ^ code) * 16777619u;
+}
+
+/**
+ * Looks up a key in the generated table
+ *
+ * @param key Position key
+ * @param direction Receives the book move if found
+ * @return true if the position is in the book
+ */
+bool openingBookLookup(uint32_t key, uint8_t &direction);
+
+/**
+ * Starts following a new game; it is in the book if all players are at their spawn points.
+ *
+ * @param heads Head positions of the first GameState
+ */
+void openingBookStart(const uint8_t heads[NUM_PLAYERS][2]);
+
+/**
+ * Follows one game tick. The game leaves the book unless every player made one step.
+ *
+ * @param steps Step direction per player (DIR_NONE for dead or teleported players)
+ * @param me Our player index (player ID - 1)
+ */
+void openingBookFollow(const uint8_t steps[NUM_PLAYERS], uint8_t me);
+
+/**
+ * Returns the book move of the current position. The move is checked against the grid,
+ * so a hash collision can never send us into a trace.
+ *
+ * @param grid Current grid
+ * @param head Our head position
+ * @param heading Direction of our last step
+ * @param direction Receives the book move
+ * @return false once the game has left the book
+ */
+bool openingBookMove(const Grid &grid, const uint8_t head[2], uint8_t heading, uint8_t &direction);
+
+/**
+ * @return Number of moves played from the book in the current game
+ */
+uint16_t openingBookMoves();
+
+#endif
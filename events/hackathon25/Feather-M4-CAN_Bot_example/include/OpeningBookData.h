@@ -0,0 +1,81 @@
+// Feather-m4-can_bot_example/include/OpeningBookData.h
+// Generated by host/book_gen.cpp - do not edit by hand, rerun the generator instead.
+// 12 ticks, up to 1 opponent turns per line, search depth 6: 408 positions.
+
+#ifndef OPENING_BOOK_DATA_H
+#define OPENING_BOOK_DATA_H
+
+#include <stdint.h>
+
+constexpr uint8_t OPENING_BOOK_TICKS = 12;
+constexpr uint32_t OPENING_BOOK_SIZE = 408;
+
+// Sorted position keys, see openingBookStep()
+constexpr uint32_t OPENING_BOOK_KEYS[OPENING_BOOK_SIZE] = {
+    0x000C5540u, 0x01367BF5u, 0x034D6F17u, 0x040C5B8Cu, 0x046D1AAFu, 0x049C3A2Du, 0x05146435u, 0x05582F3Bu,
+    0x055895C0u, 0x0561158Au, 0x06685E2Eu, 0x080C61D8u, 0x08FF8D22u, 0x09583587u, 0x09E70F75u, 0x0A3581EEu,
+    0x0A595832u, 0x0AA9C386u, 0x0ACA42D9u, 0x0B9E1CBAu, 0x0BB4CC8Fu, 0x0D636732u, 0x0DA36DAEu, 0x0E1784ADu,
+    0x0E772D0Eu, 0x0E948988u, 0x0ECA4925u, 0x0F7E72EEu, 0x103F87A1u, 0x1147AB0Du, 0x117B21C7u, 0x11D5016Eu,
+    0x1202F2A6u, 0x12C9E830u, 0x12CA4F71u, 0x1322E154u, 0x13D94E15u, 0x140C74BCu, 0x17913F84u, 0x17FDAE57u,
+    0x180C047Du, 0x184BF045u, 0x19B060D7u, 0x1B2783F2u, 0x1B635C75u, 0x1B7468F4u, 0x1BDA6DFDu, 0x1BEB2A44u,
+    0x1DBBB6C6u, 0x1ECA6255u, 0x1F8CB6C6u, 0x21183D35u, 0x2177DF75u, 0x217D4105u, 0x25BE187Du, 0x25C607ABu,
+    0x26C9A3B6u, 0x27EAC537u, 0x28EBAABDu, 0x29790E0Au, 0x29A0CFCDu, 0x2AD51E64u, 0x2B25753Bu, 0x2B748224u,
+    0x2CC2EA1Eu, 0x2D19E5EDu, 0x2D72537Fu, 0x2DBBCFF6u, 0x2E0E913Fu, 0x30339010u, 0x31BBD642u, 0x32BEAB42u,
+    0x33CC2E55u, 0x340CA71Cu, 0x3427470Cu, 0x3427B216u, 0x343B23E5u, 0x34BC4C75u, 0x35A73395u, 0x365364D9u,
+    0x3656E333u, 0x36BE67C3u, 0x36E85735u, 0x379F1275u, 0x37B0C29Cu, 0x37BC84FDu, 0x37DC3BA6u, 0x386069C5u,
+    0x38D7ADD6u, 0x390288BFu, 0x39BBE2DAu, 0x3A2323B5u, 0x3ABD6F0Du, 0x3B9BAAC4u, 0x3BDC41F2u, 0x3C4B1356u,
+    0x3D3A724Fu, 0x3DA3B93Eu, 0x3F1DB0D3u, 0x3F451B25u, 0x3F576557u, 0x3F91368Cu, 0x3FDC483Eu, 0x40A6B1FEu,
+    0x41F23F7Cu, 0x42869045u, 0x43EE34ADu, 0x440B2D4Cu, 0x44A99D94u, 0x46B0BC36u, 0x471ECEDAu, 0x4831B39Fu,
+    0x483C1B2Fu, 0x484C1DFDu, 0x48B93687u, 0x48F9D41Au, 0x49589A47u, 0x4959EB7Bu, 0x497B7A02u, 0x49A3CC22u,
+    0x49B1FD4Au, 0x4ABDB85Cu, 0x4BDC5B22u, 0x4C9BB0EEu, 0x4C9C22ADu, 0x4CD62DD8u, 0x4D27D0F8u, 0x4DA3D26Eu,
+    0x4E173335u, 0x4E2B4A25u, 0x4ECAADE5u, 0x4F37FF05u, 0x50D25EA7u, 0x512F8B25u, 0x51A3D8BAu, 0x52AC9F1Du,
+    0x54D977A1u, 0x56921D72u, 0x56F6459Au, 0x571D550Au, 0x576A3A0Cu, 0x5891219Du, 0x5D2D2A4Eu, 0x5D710C0Fu,
+    0x5DA3EB9Eu, 0x5E03A4B9u, 0x5E8E3274u, 0x5EEF7BA7u, 0x5EF1D685u, 0x5F382077u, 0x5FE47EE2u, 0x5FF35E25u,
+    0x6057C5C9u, 0x61F06E46u, 0x6247C7E7u, 0x6285FF9Cu, 0x652738E7u, 0x665B19C9u, 0x667D40F9u, 0x66834097u,
+    0x67E3DFFDu, 0x67EB6F24u, 0x69711EF3u, 0x6A33D955u, 0x6A66F4EBu, 0x6BDC8D82u, 0x6C56573Au, 0x6C83B366u,
+    0x6CA5BD86u, 0x6CADF4D5u, 0x6CC004CEu, 0x6CF3C0C3u, 0x6D11A0AAu, 0x6D1E63F6u, 0x6D71253Fu, 0x6DBAA1B6u,
+    0x6DE2DECCu, 0x6E02AFF5u, 0x6F2C551Fu, 0x6F9F1835u, 0x70248942u, 0x7060FA12u, 0x71712B8Bu, 0x71E7487Eu,
+    0x73CC32E5u, 0x754E522Fu, 0x771D876Au, 0x77362117u, 0x77C06114u, 0x77D47ACCu, 0x78FD3CCEu, 0x797FF547u,
+    0x7A35C026u, 0x7AAE1D0Du, 0x7AB4F137u, 0x7B1D8DB6u, 0x7B9424AEu, 0x7BDCA6B2u, 0x7C7A7772u, 0x7D713E6Fu,
+    0x7E330F36u, 0x7E599622u, 0x7EEFD2DAu, 0x7F3B5FE6u, 0x7F7E00BCu, 0x7F8B34C0u, 0x7FBE97EAu, 0x803F1915u,
+    0x80518C1Cu, 0x811C9DC5u, 0x820EAE1Du, 0x8284D744u, 0x831D9A4Eu, 0x834C07B5u, 0x83D6AE1Du, 0x83EC7B68u,
+    0x841781F1u, 0x843D3D1Au, 0x847DB2F5u, 0x84E08BD3u, 0x871DA09Au, 0x8742C054u, 0x87A74435u, 0x883B916Au,
+    0x89861BCEu, 0x8A040EE6u, 0x8C24108Cu, 0x8C36947Eu, 0x8C786D1Au, 0x8C9D821Eu, 0x8CD2985Au, 0x8D28BD9Cu,
+    0x8DA4372Eu, 0x8E4207EEu, 0x8EC74435u, 0x8F12B576u, 0x8FAFAA9Eu, 0x910C66EDu, 0x910DBCD7u, 0x912403C2u,
+    0x91515AEDu, 0x91B1E006u, 0x91B251C5u, 0x92BACBFCu, 0x947E7765u, 0x949F39FFu, 0x94D8CDC3u, 0x97E42B8Du,
+    0x97F3FE77u, 0x98FCE60Bu, 0x98FFA8C6u, 0x9A6F3662u, 0x9B197A92u, 0x9BE431D9u, 0x9C057797u, 0x9C76A966u,
+    0x9CC4BC5Cu, 0x9DE38FB6u, 0x9DE84C82u, 0x9EF21557u, 0x9FE974B5u, 0xA1739125u, 0xA2196010u, 0xA301DAC0u,
+    0xA3E43E71u, 0xA5395C2Bu, 0xA580D475u, 0xA7D25E9Au, 0xA7E444BDu, 0xA9125C8Bu, 0xAAC54117u, 0xAB1BDAA6u,
+    0xAB73B8A4u, 0xAB74481Cu, 0xAB98B68Au, 0xACD2263Fu, 0xACF4E3A1u, 0xAD0DF075u, 0xAD7189FFu, 0xAF18274Fu,
+    0xAF9C6935u, 0xB0CA38DCu, 0xB160A805u, 0xB199E27Eu, 0xB1CCA6D9u, 0xB22CF903u, 0xB2B4FB62u, 0xB3676A4Du,
+    0xB451AEB5u, 0xB4611905u, 0xB4ECDA7Fu, 0xB50A2C55u, 0xB5A7FD15u, 0xB7E45DEDu, 0xB86CBF5Cu, 0xB9C5A6B6u,
+    0xB9C61875u, 0xBB4A132Eu, 0xBC24A840u, 0xBCA169B5u, 0xBD34C8DAu, 0xBD98B29Fu, 0xBF10C343u, 0xBF3B2357u,
+    0xBFCF1FBEu, 0xC0123C47u, 0xC07BB869u, 0xC09FFD8Bu, 0xC16A2E21u, 0xC29D5E17u, 0xC40BF6CCu, 0xC40EB254u,
+    0xC4A7FF4Au, 0xC4E7D476u, 0xC53154F5u, 0xC569AB02u, 0xC5A81645u, 0xC5BBD2F4u, 0xC5C21C37u, 0xC6B3A496u,
+    0xC71E055Au, 0xC7D32D68u, 0xC82F5C30u, 0xC92A24BCu, 0xC957D0C7u, 0xC98570EEu, 0xC9F73487u, 0xCBB48232u,
+    0xCBDB1589u, 0xCE2AF2BAu, 0xCEC9E465u, 0xCF28DB86u, 0xCF694825u, 0xCFC5D0AEu, 0xCFD89674u, 0xD1F16EFFu,
+    0xD2D6EED4u, 0xD44B581Eu, 0xD49EB03Au, 0xD7F0E35Au, 0xD930DA87u, 0xD957E9F7u, 0xD96741E7u, 0xDA855C72u,
+    0xDC60BE54u, 0xDC942872u, 0xDCC4DAE7u, 0xDD49331Fu, 0xDD994324u, 0xDF740A80u, 0xE089B17Du, 0xE2228EF5u,
+    0xE24084E8u, 0xE41E280Au, 0xE5A848A5u, 0xE5B42014u, 0xE5D60624u, 0xE605CE79u, 0xE669911Fu, 0xE74545BDu,
+    0xE7741718u, 0xE7BCF6FFu, 0xE7E4A97Du, 0xE8158F3Fu, 0xE8CCA2C7u, 0xEA106057u, 0xEA1C30D7u, 0xEB6502B2u,
+    0xEB741D64u, 0xEC0F0AD0u, 0xED735D39u, 0xED87BEEEu, 0xEDBB6B36u, 0xEE12F532u, 0xEE5ACEF6u, 0xEED8719Bu,
+    0xEF31A294u, 0xEFF36A15u, 0xF12B1882u, 0xF18EE8F5u, 0xF1A3E3B5u, 0xF1A85B89u, 0xF313BD42u, 0xF326E67Fu,
+    0xF39ADDF5u, 0xF3E71F9Eu, 0xF4F1C754u, 0xF5A861D5u, 0xF745605Au, 0xF91B1493u, 0xF9581C57u, 0xF9A86821u,
+    0xF9BD6624u, 0xFB1F44CCu, 0xFB3C7972u, 0xFB743694u, 0xFB845E76u, 0xFBD62C6Fu, 0xFBDBDD32u, 0xFCACB482u,
+    0xFD091BECu, 0xFD5822A3u, 0xFD708104u, 0xFD7C450Eu, 0xFDBB8466u, 0xFECA2FF5u, 0xFED80595u, 0xFF40F145u,
+};
+
+// Move of each key, 2 bits each (direction - 1), four keys per byte
+constexpr uint8_t OPENING_BOOK_MOVES[(OPENING_BOOK_SIZE + 3) / 4] = {
+    0x04, 0x40, 0x33, 0xD4, 0x04, 0x11, 0xC1, 0x70, 0xC1, 0x50, 0x04, 0xEC,
+    0x41, 0x10, 0x47, 0xCC, 0x52, 0x15, 0x42, 0x04, 0xCC, 0x00, 0x15, 0x4F,
+    0x07, 0x43, 0x81, 0x07, 0x35, 0x51, 0x43, 0x70, 0x01, 0x11, 0x00, 0x51,
+    0x71, 0x08, 0x14, 0x01, 0x14, 0x62, 0x11, 0x5C, 0x70, 0x50, 0x04, 0x4D,
+    0x20, 0x43, 0x45, 0x23, 0x04, 0x80, 0x00, 0x1C, 0x57, 0x0C, 0x5F, 0x05,
+    0x04, 0x04, 0x05, 0x40, 0x04, 0x00, 0x00, 0x54, 0x73, 0x30, 0x48, 0x00,
+    0x00, 0xC0, 0x5E, 0x17, 0x35, 0xC0, 0x84, 0x58, 0xC0, 0x3D, 0x45, 0x74,
+    0x02, 0x15, 0x53, 0x0F, 0xC0, 0xBD, 0x44, 0x11, 0xCF, 0xD5, 0x03, 0x40,
+    0x35, 0x10, 0xE4, 0xC1, 0x55, 0x01,
+};
+
+#endif
@@ -0,0 +1,141 @@
+// Feather-m4-can_bot_example/include/Profiler.h
+/**
+ * @file Profiler.h
+ * @brief Scoped timing zones for finding where the per-tick time goes
+ *
+ * PROFILE_ZONE(id) at the top of a block times the rest of that block. Every zone records its
+ * calls, its inclusive time (including nested zones) and its exclusive time (without them).
+ * The firmware reads the DWT cycle counter of the Cortex-M4, all other builds use
+ * std::chrono::steady_clock. process_GameFinish prints a report and starts over.
+ *
+ * Enabled with -DTRON_PROFILE in build_flags. Without it every macro expands to nothing.
+ *
+ * A CAN callback that interrupts loop() inside a zone simply nests into it, so its time counts
+ * as a child of that zone. In host builds each thread keeps its own nesting.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+
+/**
+ * Compile-time zone IDs; add new zones before ZONE_COUNT and name them in Profiler.cpp
+ */
+enum ProfileZone : uint8_t
+{
+    ZONE_ON_RECEIVE,    // CAN receive callback, all messages
+    ZONE_GAME_STATE,    // GameLoop::gameState, including the strategy
+    ZONE_OPENING_BOOK,  // Book lookup
+    ZONE_DECIDE_MOVE,   // Live or speculative move decision
+    ZONE_SEARCH,        // Game search
+    ZONE_EVALUATE_MOVE, // evaluateMove, chooseMove and mlpChooseMove
+    ZONE_FLOOD_FILL,    // calculateAccessibleArea, a single full fill
+    ZONE_COMPARE_FILL,  // compareAccessibleAreas, the early-terminating fill of chooseMove
+    ZONE_SPECULATION,   // One speculation step in loop()
+    ZONE_COUNT
+};
+
+#ifdef TRON_PROFILE
+
+#if defined(__arm__)
+#include <Arduino.h>
+typedef uint32_t ProfileTicks; // Wraps after 35 s at 120 MHz, longer than any zone
+#ifdef F_CPU
+const uint32_t PROFILE_TICKS_PER_US = F_CPU / 1000000;
+#else
+const uint32_t PROFILE_TICKS_PER_US = 120;
+#endif
+inline ProfileTicks profilerNow() { return DWT->CYCCNT; }
+#define PROFILE_THREAD_LOCAL
+#else
+#include <chrono>
+typedef uint64_t ProfileTicks;
+const uint32_t PROFILE_TICKS_PER_US = 1000;
+inline ProfileTicks profilerNow()
+{
+    return (ProfileTicks)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+#define PROFILE_THREAD_LOCAL thread_local
+#endif
+
+struct ProfileZoneStats
+{
+    uint32_t calls;
+    uint64_t inclusive;    // Ticks, outermost calls only if a zone nests into itself
+    uint64_t exclusive;    // Ticks without nested zones
+    uint64_t maxInclusive; // Longest single call
+};
+
+class ProfileScope;
+
+extern ProfileZoneStats profile_zones[ZONE_COUNT];
+extern PROFILE_THREAD_LOCAL ProfileScope *profile_current;
+extern PROFILE_THREAD_LOCAL uint8_t profile_active[ZONE_COUNT];
+
+/**
+ * Adds one finished call to a zone; atomic against the CAN callback and host threads
+ */
+void profilerRecord(ProfileZone zone, uint64_t inclusive, uint64_t exclusive, bool outermost);
+
+/**
+ * Times one zone from construction to destruction
+ */
+class ProfileScope
+{
+public:
+    explicit ProfileScope(ProfileZone zone)
+        : zone_(zone), parent_(profile_current), children_(0), outermost_(profile_active[zone]++ == 0)
+    {
+        profile_current = this;
+        start_ = profilerNow();
+    }
+
+    ~ProfileScope()
+    {
+        ProfileTicks elapsed = profilerNow() - start_;
+        profile_current = parent_;
+        profile_active[zone_]--;
+        if (parent_)
+            parent_->children_ += elapsed;
+        profilerRecord(zone_, elapsed, elapsed - children_, outermost_);
+    }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    ProfileZone zone_;
+    ProfileScope *parent_;
+    ProfileTicks start_;
+    ProfileTicks children_;
+    bool outermost_;
+};
+
+/**
+ * Starts the cycle counter on the M4; call once from setup()
+ */
+void profilerInit();
+
+/**
+ * Prints the zone table since the last reset and resets all zones
+ */
+void profilerReport();
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(zone) ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(zone)
+#define PROFILE_INIT() profilerInit()
+#define PROFILE_REPORT() profilerReport()
+
+#else
+
+#define PROFILE_ZONE(zone) ((void)0)
+#define PROFILE_INIT() ((void)0)
+#define PROFILE_REPORT() ((void)0)
+
+#endif
+
+#endif
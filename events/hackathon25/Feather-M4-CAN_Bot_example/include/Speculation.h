@@ -0,0 +1,77 @@
+// Feather-m4-can_bot_example/include/Speculation.h
+/**
+ * @file Speculation.h
+ * @brief Speculative precomputation of our next move between two game ticks
+ *
+ * After our move is sent, the next GameState can only differ from the current one by one step
+ * of every player. Our own step is known, so the next board is one of at most 3^3 opponent
+ * combinations. They are ranked by the last known headings (going straight is most likely) and
+ * evaluated one per loop() call while the MCU would otherwise idle. When the next GameState
+ * matches a finished candidate, the move is a table lookup.
+ *
+ * Threading: speculationPrepare(), speculationLookup() and speculationInvalidate() run in the
+ * CAN receive callback, speculationStep() in loop(). A generation counter discards results that
+ * were computed for a tick which has already passed.
+ */
+
+#ifndef SPECULATION_H
+#define SPECULATION_H
+
+#include <stdint.h>
+#include "TronCore.h"
+
+// At most three moves for each of the three opponents
+const uint8_t MAX_SPECULATIONS = 27;
+
+/**
+ * Picks our move for a board; the speculation uses the same function as the live decision
+ */
+typedef uint8_t (*MoveDecider)(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], const uint8_t headings[NUM_PLAYERS]);
+
+struct SpeculationStats
+{
+    uint32_t hits;      // Next GameState matched a finished candidate
+    uint32_t notReady;  // Matched a candidate that was not evaluated in time
+    uint32_t misses;    // Not among the candidates (unlikely move or repeated state)
+    uint32_t skipped;   // No candidates: first tick, or a player died in between
+    uint32_t evaluated; // Candidates finished before their tick
+    uint32_t prepared;  // Candidates generated
+};
+
+/**
+ * Generates the ranked candidates for the next GameState. Call after sending our move.
+ *
+ * @param grid Current grid including all heads
+ * @param heads Current head positions, NO_POSITION for dead players
+ * @param headings Last step direction of every player
+ * @param me Our player index (player ID - 1)
+ * @param our_move Direction we just sent
+ */
+void speculationPrepare(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], const uint8_t headings[NUM_PLAYERS],
+                        uint8_t me, uint8_t our_move);
+
+/**
+ * Looks up the precomputed move for a GameState and updates the statistics
+ *
+ * @param heads Head positions from the GameState message
+ * @param direction Receives the move on a hit
+ * @return true on a hit
+ */
+bool speculationLookup(const uint8_t heads[NUM_PLAYERS][2], uint8_t &direction);
+
+/**
+ * Drops all candidates, e.g. because a Die message changes the grid
+ */
+void speculationInvalidate();
+
+/**
+ * Evaluates the next most likely candidate. Call from loop().
+ *
+ * @return false if there was nothing left to evaluate
+ */
+bool speculationStep(MoveDecider decide);
+
+const SpeculationStats &speculationStats();
+void speculationResetStats();
+
+#endif
@@ -0,0 +1,104 @@
+// Feather-m4-can_bot_example/include/Strategy.h
+/**
+ * @file Strategy.h
+ * @brief Interface of the decision engines the game loop is instantiated with
+ *
+ * A strategy is a plain class that GameLoop (GameLoop.h) takes as its template parameter.
+ * Every hook is resolved at compile time, so there are no virtual calls and hooks a strategy
+ * does not need are empty inline functions that compile away. A build selects its strategy
+ * with -DTRON_STRATEGY=<class>; platformio.ini has a firmware and a bus simulation
+ * environment per strategy.
+ *
+ * StrategyBase provides the default of every hook. A strategy derives from it and declares
+ * the hooks it needs with the same signature, which hides the default:
+ * - name(): shown in the serial log
+ * - start(): first GameState of a game, all heads on their spawn points
+ * - step(): every further GameState in which at least one player moved
+ * - decide(): our move for the current GameState, 0 if there is none
+ * - moveSent(): after the move went out, e.g. to precompute the next one
+ * - released(): a dead player's trace was removed from the grid
+ * - finish(): on GameFinish, print statistics and reset per-game state
+ * - idle(): from loop() between messages; false if there is nothing to do
+ *
+ * Hooks other than idle() run in the CAN receive callback.
+ */
+
+#ifndef STRATEGY_H
+#define STRATEGY_H
+
+#include <stdint.h>
+#include <utility>
+#include <vector>
+#include "TronCore.h"
+
+typedef std::vector<std::pair<uint8_t, uint8_t>> Trace;
+
+class StrategyBase
+{
+public:
+    static const char *name() { return "unnamed"; }
+
+    /**
+     * @param grid Grid with the spawn points marked
+     * @param heads Head positions, NO_POSITION for players that are not in the game
+     * @param me Our player index (player ID - 1)
+     */
+    void start(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], uint8_t me)
+    {
+        (void)grid;
+        (void)heads;
+        (void)me;
+    }
+
+    /**
+     * @param steps Direction of every player's last step, DIR_NONE for players that did not move
+     */
+    void step(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], const uint8_t steps[NUM_PLAYERS], uint8_t me)
+    {
+        (void)grid;
+        (void)heads;
+        (void)steps;
+        (void)me;
+    }
+
+    /**
+     * @param headings Last step direction of every player
+     * @return Direction to send (1-4), 0 to send nothing
+     */
+    uint8_t decide(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], const uint8_t headings[NUM_PLAYERS],
+                   uint8_t me)
+    {
+        (void)grid;
+        (void)heads;
+        (void)me;
+        return headings[me];
+    }
+
+    void moveSent(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], const uint8_t headings[NUM_PLAYERS],
+                  uint8_t me, uint8_t direction)
+    {
+        (void)grid;
+        (void)heads;
+        (void)headings;
+        (void)me;
+        (void)direction;
+    }
+
+    /**
+     * @param grid Grid with the trace already removed
+     * @param player Index of the dead player
+     * @param trace The removed cells
+     */
+    void released(const Grid &grid, uint8_t player, const Trace &trace)
+    {
+        (void)grid;
+        (void)player;
+        (void)trace;
+    }
+
+    void finish() {}
+
+    bool idle() { return false; }
+};
+
+#endif
@@ -0,0 +1,168 @@
+// Feather-m4-can_bot_example/include/TronCore.h
+/**
+ * @file TronCore.h
+ * @brief Board model and game rules shared by the firmware and host builds
+ *
+ * Defines:
+ * - Grid dimensions and direction vectors
+ * - The TronState snapshot used by the game search
+ * - Simultaneous move resolution as specified in protocol.md
+ * - The flood fill used to measure accessible area
+ *
+ * Nothing in here depends on the Arduino core, so it compiles unchanged on a PC.
+ */
+
+#ifndef TRON_CORE_H
+#define TRON_CORE_H
+
+#include <stdint.h>
+
+// Constants for grid dimensions
+const uint8_t GRID_WIDTH = 64;
+const uint8_t GRID_HEIGHT = 64;
+const uint8_t NUM_PLAYERS = 4;
+
+// Coordinate used by the server for players that already died
+const uint8_t NO_POSITION = 255;
+
+/**
+ * Movement directions as encoded in the Move message
+ */
+enum Direction : uint8_t
+{
+    DIR_NONE = 0,
+    DIR_UP = 1,
+    DIR_RIGHT = 2,
+    DIR_DOWN = 3,
+    DIR_LEFT = 4
+};
+
+// Spawn points per player from protocol.md
+const uint8_t SPAWN_X[NUM_PLAYERS] = {16, 48, 48, 16};
+const uint8_t SPAWN_Y[NUM_PLAYERS] = {48, 48, 16, 16};
+
+// Direction vectors, indexed by direction - 1
+const int dx[] = {0, 1, 0, -1}; // UP, RIGHT, DOWN, LEFT
+const int dy[] = {-1, 0, 1, 0};
+
+/**
+ * Grid cell contents: 0 = free, otherwise the 1-based ID of the player whose trace covers the cell
+ */
+typedef uint8_t Grid[GRID_WIDTH][GRID_HEIGHT];
+
+/**
+ * Complete game position as seen by the game search
+ *
+ * Copyable by value, so the search can apply moves to a copy of its parent.
+ */
+struct TronState
+{
+    Grid grid;                // Traces of all players, owner per cell
+    uint8_t x[NUM_PLAYERS];   // Head positions, NO_POSITION once dead
+    uint8_t y[NUM_PLAYERS];
+    uint8_t heading[NUM_PLAYERS]; // Direction of the last step, DIR_UP at spawn
+    uint8_t alive;            // Bit i set while player i + 1 is alive
+    uint64_t hash;            // Zobrist key of grid, heads and headings
+};
+
+/**
+ * splitmix64 finalizer, used to derive Zobrist keys on the fly instead of storing a 32 KB table
+ */
+inline uint64_t zobristMix(uint64_t z)
+{
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Zobrist key of a trace cell with the 1-based ID of its owner
+inline uint64_t zobristCellKey(uint8_t x, uint8_t y, uint8_t owner)
+{
+    return zobristMix(((uint64_t)x * GRID_HEIGHT + y) * 8 + owner);
+}
+
+// Zobrist key of a living player's head and heading
+inline uint64_t zobristHeadKey(uint8_t player, uint8_t x, uint8_t y, uint8_t heading)
+{
+    return zobristMix(0x100000ULL + (((uint64_t)x * GRID_HEIGHT + y) * 8 + heading) * 4 + player);
+}
+
+inline uint8_t wrapX(int x) { return (uint8_t)((x + GRID_WIDTH) % GRID_WIDTH); }
+inline uint8_t wrapY(int y) { return (uint8_t)((y + GRID_HEIGHT) % GRID_HEIGHT); }
+
+/**
+ * @return true if turning from heading to direction would be a 180 degree turn
+ */
+inline bool isReverse(uint8_t direction, uint8_t heading)
+{
+    return direction != DIR_NONE && heading != DIR_NONE && (heading + 1) % 4 + 1 == direction;
+}
+
+/**
+ * Derives the direction of a single step from one position to the next (with wrap-around)
+ *
+ * @return Direction of the step, DIR_NONE if the positions are not adjacent
+ */
+uint8_t directionBetween(uint8_t fromX, uint8_t fromY, uint8_t toX, uint8_t toY);
+
+/**
+ * Shortest distance between two cells on the wrapping grid
+ */
+uint8_t wrappedDistance(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2);
+
+/**
+ * Initializes a state with the four spawn points from protocol.md, all heading UP
+ */
+void initTronState(TronState &state);
+
+/**
+ * Recomputes the Zobrist key of a state from scratch
+ */
+uint64_t computeHash(const TronState &state);
+
+/**
+ * Advances the state by one game tick.
+ *
+ * Follows the server rules: reverse or missing moves keep the current heading, a player
+ * dies if the target cell was occupied or another player moves into the same cell, and the
+ * traces of all players that died in this tick are removed only after all deaths are known.
+ *
+ * @param state State to update in place
+ * @param moves Requested direction per player (DIR_NONE keeps the heading)
+ * @return Bit mask of the players that died in this tick
+ */
+uint8_t applyMoves(TronState &state, const uint8_t moves[NUM_PLAYERS]);
+
+/**
+ * Flood fill to calculate accessible area from a given position.
+ *
+ * @param grid Grid to search, any non-zero cell is blocked
+ * @param x Starting x-coordinate
+ * @param y Starting y-coordinate
+ * @return Number of accessible cells, including the start cell
+ */
+int calculateAccessibleArea(const Grid &grid, uint8_t x, uint8_t y);
+
+// Most start cells compareAccessibleAreas() takes, one per possible move
+const uint8_t MAX_FILL_REGIONS = 4;
+
+/**
+ * Flood fills from several start cells at once to rank them by accessible area.
+ *
+ * All regions grow in lockstep. Regions that meet are one component and get the same area.
+ * The fill stops as soon as the ranking is decided: all regions but one are complete and the
+ * remaining one is more than margin cells larger than every other. That region's area is then
+ * only a lower bound, which is still larger than all others by more than margin.
+ *
+ * @param grid Grid to search, any non-zero cell is blocked
+ * @param starts Distinct free start cells
+ * @param count Number of start cells, at most MAX_FILL_REGIONS
+ * @param margin Cells by which the leader must be ahead to stop early, negative for exact areas
+ * @param cap Areas of at least cap cells count as cap ("enough space"), 0 for no cap
+ * @param areas Receives the area per start cell
+ */
+void compareAccessibleAreas(const Grid &grid, const uint8_t starts[][2], uint8_t count, int margin, int cap,
+                            int areas[]);
+
+#endif
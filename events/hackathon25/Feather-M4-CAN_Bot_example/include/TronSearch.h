@@ -0,0 +1,172 @@
+// Feather-m4-can_bot_example/include/TronSearch.h
+/**
+ * @file TronSearch.h
+ * @brief Depth-limited game search over simultaneous 4-player moves
+ *
+ * Defines:
+ * - The transposition table shared by all search threads
+ * - Move generation for our player and the opponents
+ * - The sequential alpha-beta search used on the microcontroller
+ *
+ * The search is paranoid: for each of our moves, the opponents near our head are
+ * assumed to pick the joint reply that is worst for us. Opponents that are too far
+ * away to interact within the search horizon keep their heading. Leaves are scored
+ * with the flood fill from our head.
+ *
+ * The tree is walked on one Board (Board.h) with make/unmake, so a ply adds a few hundred
+ * bytes of stack instead of a 4 KB TronState copy. The entry points that take a TronState
+ * load it into a Board on their own stack (about 4 KB, once per call).
+ */
+
+#ifndef TRON_SEARCH_H
+#define TRON_SEARCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Board.h"
+#include "TronCore.h"
+
+#ifdef TRON_HOST
+#include <atomic>
+#endif
+
+// Scores for decided positions, outside of the range of any flood fill result
+const float SCORE_LOSS = -1000.0f;
+const float SCORE_WIN = 5000.0f;
+
+const uint8_t SEARCH_MAX_DEPTH = 16;
+const uint8_t MAX_OUR_MOVES = 3;
+const uint8_t MAX_REPLIES = 27; // 3 moves for each of up to 3 opponents
+
+/**
+ * Result of a search from the root position
+ */
+struct SearchResult
+{
+    uint8_t direction; // Best direction (1-4), DIR_NONE if we are already dead
+    float score;       // Search score of that direction
+    uint64_t nodes;    // Number of visited positions
+};
+
+enum TTBound : uint8_t
+{
+    TT_NONE = 0,
+    TT_EXACT = 1,
+    TT_LOWER = 2, // Score is a lower bound (search failed high)
+    TT_UPPER = 3  // Score is an upper bound (search failed low)
+};
+
+struct TTEntry
+{
+    float score;
+    uint8_t depth;
+    uint8_t bound;
+    uint8_t move;
+};
+
+/**
+ * Lockless transposition table.
+ *
+ * Each slot stores the packed entry and the key XOR the entry. Concurrent writers can tear a
+ * slot, but then the XOR check fails on probe and the slot is treated as a miss, so threads in
+ * host builds share one table without locks. The firmware build uses plain words.
+ */
+class TranspositionTable
+{
+public:
+#ifdef TRON_HOST
+    typedef std::atomic<uint64_t> Word;
+#else
+    typedef uint64_t Word;
+#endif
+
+    struct Slot
+    {
+        Word check;
+        Word data;
+    };
+
+    /**
+     * @param slots Storage for the table, owned by the caller
+     * @param count Number of slots, must be a power of two
+     */
+    TranspositionTable(Slot *slots, size_t count);
+
+    bool probe(uint64_t key, TTEntry &entry) const;
+    void store(uint64_t key, const TTEntry &entry);
+    void clear();
+
+    size_t size() const { return mask_ + 1; }
+
+private:
+    Slot *slots_;
+    size_t mask_;
+};
+
+/**
+ * Transposition table key of a position searched for the given player
+ */
+inline uint64_t searchKey(const TronState &state, uint8_t me)
+{
+    return state.hash ^ ((uint64_t)(me + 1) * 0x9E3779B97F4A7C15ULL);
+}
+
+inline uint64_t searchKey(const Board &board, uint8_t me)
+{
+    return board.hash() ^ ((uint64_t)(me + 1) * 0x9E3779B97F4A7C15ULL);
+}
+
+/**
+ * Per-thread search state
+ */
+struct SearchContext
+{
+    uint8_t me;              // Our player index (player ID - 1)
+    TranspositionTable *tt;  // Optional, may be nullptr
+    uint64_t nodes;
+};
+
+/**
+ * Lists our legal (non-reversing) moves, the transposition table move first.
+ *
+ * @return Number of moves written to moves
+ */
+uint8_t generateOurMoves(const TronState &state, uint8_t me, uint8_t ttMove, uint8_t moves[MAX_OUR_MOVES]);
+uint8_t generateOurMoves(const Board &board, uint8_t me, uint8_t ttMove, uint8_t moves[MAX_OUR_MOVES]);
+
+/**
+ * Lists the joint opponent replies to consider at the given remaining depth.
+ *
+ * Opponents within reach of our head branch over their non-suicidal moves, the others
+ * continue straight (or take the first free turn). Our own slot is left as DIR_NONE.
+ *
+ * @return Number of replies written to replies
+ */
+uint8_t generateReplies(const TronState &state, uint8_t me, uint8_t depth, uint8_t replies[MAX_REPLIES][NUM_PLAYERS]);
+uint8_t generateReplies(const Board &board, uint8_t me, uint8_t depth, uint8_t replies[MAX_REPLIES][NUM_PLAYERS]);
+
+/**
+ * Static evaluation of a position from our point of view: the accessible area from our head.
+ * The Board version fills the bitboard and counts the same cells.
+ */
+float evaluateLeaf(const TronState &state, uint8_t me);
+float evaluateLeaf(const Board &board, uint8_t me);
+
+/**
+ * Fail-soft alpha-beta search of a position with the given remaining depth. The Board is
+ * changed during the search and restored before returning.
+ */
+float searchValue(SearchContext &context, Board &board, uint8_t depth, float alpha, float beta);
+float searchValue(SearchContext &context, const TronState &state, uint8_t depth, float alpha, float beta);
+
+/**
+ * Iterative deepening search from the root position on the calling thread
+ *
+ * @param state Current position
+ * @param me Our player index (player ID - 1)
+ * @param depth Number of ticks to look ahead
+ * @param tt Optional transposition table
+ */
+SearchResult searchBestMove(const TronState &state, uint8_t me, uint8_t depth, TranspositionTable *tt);
+
+#endif
@@ -0,0 +1,37 @@
+// Feather-m4-can_bot_example/include/TunedStrategy.h
+/**
+ * @file TunedStrategy.h
+ * @brief The main bot: opening book, speculation, endgame solver and the tuned evaluation
+ *
+ * Per GameState it plays, in this order:
+ * - the opening book move while the game follows the book
+ * - the move precomputed in loop() if the opponents moved as predicted
+ * - otherwise a fresh decision: the endgame solver when sealed in a small pocket, else the game
+ *   search (SEARCH_DEPTH > 0), the move network (MLP_EVAL) or the one-ply evaluation
+ *
+ * Build options (see TunedStrategy.cpp): SEARCH_DEPTH, SEARCH_THREADS, SEARCH_TT_SLOTS,
+ * MLP_EVAL and the ENDGAME_* limits of EndgameSolver.h.
+ */
+
+#ifndef TUNED_STRATEGY_H
+#define TUNED_STRATEGY_H
+
+#include "Strategy.h"
+
+class TunedStrategy : public StrategyBase
+{
+public:
+    static const char *name() { return "tuned"; }
+
+    void start(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], uint8_t me);
+    void step(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], const uint8_t steps[NUM_PLAYERS], uint8_t me);
+    uint8_t decide(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], const uint8_t headings[NUM_PLAYERS],
+                   uint8_t me);
+    void moveSent(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], const uint8_t headings[NUM_PLAYERS],
+                  uint8_t me, uint8_t direction);
+    void released(const Grid &grid, uint8_t player, const Trace &trace);
+    void finish();
+    bool idle();
+};
+
+#endif
@@ -0,0 +1,22 @@
+// Feather-m4-can_bot_example/include/TunedWeights.h
+// Generated by host/tuner.cpp - do not edit by hand, rerun the tuner instead.
+// SPSA: 200 iterations x 64 games, seed 1, mixed opponents. Validation: +0.435 points
+// per game more than the previous weights in 2000 games against the same opponents.
+// Only distance, wall_bonus and straight_bonus are tuned, the others are fixed.
+
+#ifndef TUNED_WEIGHTS_H
+#define TUNED_WEIGHTS_H
+
+#include "EvalWeights.h"
+
+constexpr EvalWeights TUNED_WEIGHTS = {
+    10.0f,     // space
+    8.00736f,  // distance
+    7.99025f,  // wall_bonus
+    -2.51849f, // straight_bonus
+    -2000.0f,  // reversal_penalty
+    -1000.0f,  // collision_penalty
+    -500.0f,   // survival_threshold
+};
+
+#endif
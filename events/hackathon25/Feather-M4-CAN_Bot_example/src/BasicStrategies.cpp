@@ -0,0 +1,152 @@
+// Feather-m4-can_bot_example/src/BasicStrategies.cpp
+/**
+ * @file BasicStrategies.cpp
+ * @brief The earlier bots of the team as strategies on the shared game loop
+ */
+
+#include "BasicStrategies.h"
+#include <cstring>
+
+namespace
+{
+uint8_t freeNeighbours(const Grid &grid, uint8_t x, uint8_t y)
+{
+    uint8_t count = 0;
+    for (uint8_t dir = 0; dir < 4; dir++)
+        count += !grid[wrapX(x + dx[dir])][wrapY(y + dy[dir])];
+    return count;
+}
+} // namespace
+
+uint8_t FloodFillStrategy::decide(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2],
+                                  const uint8_t headings[NUM_PLAYERS], uint8_t me)
+{
+    int best_score = -1;
+    uint8_t best_direction = headings[me]; // Everything is blocked: keep going
+    for (uint8_t dir = DIR_UP; dir <= DIR_LEFT; dir++)
+    {
+        uint8_t nx = wrapX(heads[me][0] + dx[dir - 1]);
+        uint8_t ny = wrapY(heads[me][1] + dy[dir - 1]);
+        if (isReverse(dir, headings[me]) || grid[nx][ny])
+            continue;
+
+        int score = calculateAccessibleArea(grid, nx, ny) * 10 + (4 - freeNeighbours(grid, nx, ny)) * 2;
+        if (score > best_score)
+        {
+            best_score = score;
+            best_direction = dir;
+        }
+    }
+    return best_direction;
+}
+
+uint8_t RandomStrategy::decide(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2],
+                               const uint8_t headings[NUM_PLAYERS], uint8_t me)
+{
+    // Four random draws, like the original; a draw may repeat a direction
+    for (uint8_t attempt = 0; attempt < 4; attempt++)
+    {
+        rng_ ^= rng_ << 13;
+        rng_ ^= rng_ >> 17;
+        rng_ ^= rng_ << 5;
+        uint8_t dir = DIR_UP + rng_ % 4;
+        if (!isReverse(dir, headings[me]) &&
+            !grid[wrapX(heads[me][0] + dx[dir - 1])][wrapY(heads[me][1] + dy[dir - 1])])
+            return dir;
+    }
+    return 0; // Send nothing, the server keeps our heading
+}
+
+uint8_t OpenSpaceStrategy::decide(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2],
+                                  const uint8_t headings[NUM_PLAYERS], uint8_t me)
+{
+    // The scratch of calculateAccessibleArea, used for two fills in a row instead of storing
+    // the first step towards every cell. That keeps the stack at the depth of a single fill.
+    uint32_t visited[GRID_WIDTH * GRID_HEIGHT / 32];
+    uint16_t queue[GRID_WIDTH * GRID_HEIGHT];
+    uint16_t head = 0;
+    uint16_t tail = 0;
+    auto visit = [&](uint16_t cell) {
+        if (visited[cell >> 5] & (1UL << (cell & 31)))
+            return;
+        visited[cell >> 5] |= 1UL << (cell & 31);
+        queue[tail++] = cell;
+    };
+
+    // Candidate first steps
+    uint16_t starts[4];
+    uint8_t start_dirs[4];
+    uint8_t count = 0;
+    for (uint8_t dir = DIR_UP; dir <= DIR_LEFT; dir++)
+    {
+        uint8_t nx = wrapX(heads[me][0] + dx[dir - 1]);
+        uint8_t ny = wrapY(heads[me][1] + dy[dir - 1]);
+        if (isReverse(dir, headings[me]) || grid[nx][ny])
+            continue;
+        starts[count] = nx * GRID_HEIGHT + ny;
+        start_dirs[count++] = dir;
+    }
+    if (!count)
+        return headings[me];
+
+    // Target: the reachable cell with the most free neighbours, the first one in grid order
+    memset(visited, 0, sizeof(visited));
+    for (uint8_t k = 0; k < count; k++)
+        visit(starts[k]);
+    uint16_t target = 0;
+    int most = -1;
+    while (head < tail)
+    {
+        uint16_t cell = queue[head++];
+        uint8_t x = cell / GRID_HEIGHT;
+        uint8_t y = cell % GRID_HEIGHT;
+        int open = freeNeighbours(grid, x, y);
+        if (open > most || (open == most && cell < target))
+        {
+            most = open;
+            target = cell;
+        }
+        for (uint8_t dir = 0; dir < 4; dir++)
+        {
+            uint8_t nx = wrapX(x + dx[dir]);
+            uint8_t ny = wrapY(y + dy[dir]);
+            if (!grid[nx][ny])
+                visit(nx * GRID_HEIGHT + ny);
+        }
+    }
+
+    // Fill back from the target level by level. The candidates of the first level that holds
+    // any start a shortest path; of those, take the lowest direction.
+    memset(visited, 0, sizeof(visited));
+    head = 0;
+    tail = 0;
+    visit(target);
+    uint16_t level_end = 0;
+    while (head < tail)
+    {
+        if (head == level_end)
+        {
+            // The queue holds exactly the next level now
+            level_end = tail;
+            for (uint8_t k = 0; k < count; k++)
+            {
+                for (uint16_t i = head; i < level_end; i++)
+                {
+                    if (queue[i] == starts[k])
+                        return start_dirs[k];
+                }
+            }
+        }
+        uint16_t cell = queue[head++];
+        uint8_t x = cell / GRID_HEIGHT;
+        uint8_t y = cell % GRID_HEIGHT;
+        for (uint8_t dir = 0; dir < 4; dir++)
+        {
+            uint8_t nx = wrapX(x + dx[dir]);
+            uint8_t ny = wrapY(y + dy[dir]);
+            if (!grid[nx][ny])
+                visit(nx * GRID_HEIGHT + ny);
+        }
+    }
+    return start_dirs[0]; // Not reached: the target was found from one of the candidates
+}
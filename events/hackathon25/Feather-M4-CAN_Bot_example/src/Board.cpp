@@ -0,0 +1,192 @@
+// Feather-m4-can_bot_example/src/Board.cpp
+/**
+ * @file Board.cpp
+ * @brief Compact game position with make/unmake of simultaneous moves for tree search
+ */
+
+#include "Board.h"
+#include <cstring>
+
+namespace
+{
+inline uint8_t cellX(uint16_t cell) { return cell / GRID_HEIGHT; }
+inline uint8_t cellY(uint16_t cell) { return cell % GRID_HEIGHT; }
+} // namespace
+
+void Board::init(const TronState &state)
+{
+    memset(occupied_, 0, sizeof(occupied_));
+    memset(trace_, 0, sizeof(trace_));
+    memset(traceHash_, 0, sizeof(traceHash_));
+    for (uint8_t x = 0; x < GRID_WIDTH; x++)
+    {
+        for (uint8_t y = 0; y < GRID_HEIGHT; y++)
+        {
+            uint8_t owner = state.grid[x][y];
+            if (owner < 1 || owner > NUM_PLAYERS)
+                continue;
+            occupied_[x] |= 1ULL << y;
+            trace_[owner - 1][x] |= 1ULL << y;
+            traceHash_[owner - 1] ^= zobristCellKey(x, y, owner);
+        }
+    }
+
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+    {
+        x_[i] = state.x[i];
+        y_[i] = state.y[i];
+        heading_[i] = state.heading[i];
+        trailLength_[i] = 0;
+        if (state.alive & (1 << i))
+            trail_[i][trailLength_[i]++] = x_[i] * GRID_HEIGHT + y_[i];
+    }
+    alive_ = state.alive;
+    hash_ = state.hash;
+    ply_ = 0;
+}
+
+void Board::setCell(uint8_t player, uint16_t cell)
+{
+    uint64_t bit = 1ULL << cellY(cell);
+    occupied_[cellX(cell)] |= bit;
+    trace_[player][cellX(cell)] |= bit;
+    traceHash_[player] ^= zobristCellKey(cellX(cell), cellY(cell), player + 1);
+}
+
+void Board::clearCell(uint8_t player, uint16_t cell)
+{
+    uint64_t bit = 1ULL << cellY(cell);
+    occupied_[cellX(cell)] &= ~bit;
+    trace_[player][cellX(cell)] &= ~bit;
+    traceHash_[player] ^= zobristCellKey(cellX(cell), cellY(cell), player + 1);
+}
+
+uint8_t Board::make(const uint8_t moves[NUM_PLAYERS])
+{
+    Undo &undo = undo_[ply_++];
+    undo.hash = hash_;
+    memcpy(undo.heading, heading_, sizeof(heading_));
+    undo.alive = alive_;
+    undo.moved = 0;
+
+    uint8_t nextX[NUM_PLAYERS];
+    uint8_t nextY[NUM_PLAYERS];
+    uint8_t nextHeading[NUM_PLAYERS];
+    uint8_t died = 0;
+
+    // Everybody moves at the same time; collisions are checked against the old occupancy
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+    {
+        if (!(alive_ & (1 << i)))
+            continue;
+
+        uint8_t dir = moves[i];
+        if (dir < DIR_UP || dir > DIR_LEFT || isReverse(dir, heading_[i]))
+            dir = heading_[i]; // The server ignores invalid and backwards moves
+
+        hash_ ^= zobristHeadKey(i, x_[i], y_[i], heading_[i]);
+        nextHeading[i] = dir;
+        nextX[i] = wrapX(x_[i] + dx[dir - 1]);
+        nextY[i] = wrapY(y_[i] + dy[dir - 1]);
+        if (!isFree(nextX[i], nextY[i]))
+            died |= 1 << i;
+    }
+
+    // Head-on collisions: both players die
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+    {
+        if (!(alive_ & (1 << i)))
+            continue;
+        for (uint8_t j = i + 1; j < NUM_PLAYERS; j++)
+        {
+            if ((alive_ & (1 << j)) && nextX[i] == nextX[j] && nextY[i] == nextY[j])
+                died |= (1 << i) | (1 << j);
+        }
+    }
+
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+    {
+        if (!(alive_ & (1 << i)) || (died & (1 << i)))
+            continue;
+        uint16_t cell = nextX[i] * GRID_HEIGHT + nextY[i];
+        setCell(i, cell);
+        trail_[i][trailLength_[i]++] = cell;
+        undo.moved |= 1 << i;
+        x_[i] = nextX[i];
+        y_[i] = nextY[i];
+        heading_[i] = nextHeading[i];
+        hash_ ^= zobristCellKey(x_[i], y_[i], i + 1) ^ zobristHeadKey(i, x_[i], y_[i], heading_[i]);
+    }
+
+    // Only after all deaths of this tick are known, the traces of the dead disappear
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+    {
+        if (!(died & (1 << i)))
+            continue;
+        for (uint8_t x = 0; x < GRID_WIDTH; x++)
+            occupied_[x] &= ~trace_[i][x];
+        hash_ ^= traceHash_[i];
+        x_[i] = NO_POSITION;
+        y_[i] = NO_POSITION;
+    }
+    alive_ &= ~died;
+    undo.died = died;
+    return died;
+}
+
+void Board::unmake()
+{
+    const Undo &undo = undo_[--ply_];
+
+    // Nobody entered a cell of the players that died in this tick, so their traces come back whole
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+    {
+        if (!(undo.died & (1 << i)))
+            continue;
+        for (uint8_t x = 0; x < GRID_WIDTH; x++)
+            occupied_[x] |= trace_[i][x];
+        uint16_t head = trail_[i][trailLength_[i] - 1];
+        x_[i] = cellX(head);
+        y_[i] = cellY(head);
+    }
+
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+    {
+        if (!(undo.moved & (1 << i)))
+            continue;
+        clearCell(i, trail_[i][--trailLength_[i]]);
+        uint16_t head = trail_[i][trailLength_[i] - 1];
+        x_[i] = cellX(head);
+        y_[i] = cellY(head);
+    }
+
+    memcpy(heading_, undo.heading, sizeof(heading_));
+    alive_ = undo.alive;
+    hash_ = undo.hash;
+}
+
+uint8_t Board::owner(uint8_t x, uint8_t y) const
+{
+    if (isFree(x, y))
+        return 0;
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+    {
+        if ((alive_ & (1 << i)) && ((trace_[i][x] >> y) & 1))
+            return i + 1;
+    }
+    return 0;
+}
+
+void Board::toState(TronState &state) const
+{
+    for (uint8_t x = 0; x < GRID_WIDTH; x++)
+    {
+        for (uint8_t y = 0; y < GRID_HEIGHT; y++)
+            state.grid[x][y] = owner(x, y);
+    }
+    memcpy(state.x, x_, sizeof(x_));
+    memcpy(state.y, y_, sizeof(y_));
+    memcpy(state.heading, heading_, sizeof(heading_));
+    state.alive = alive_;
+    state.hash = hash_;
+}
@@ -11,12 +11,17 @@
 
 #include "GameLogic.h"
 #include "CANHandler.h"
+#include "Profiler.h"
 
 /**
  * Hardware ID from device-specific register - unique identifier for this device
  * Used by the game server to distinguish between different player controllers
  */
+#ifdef HOST_HARDWARE_ID
+const uint32_t hardware_ID = HOST_HARDWARE_ID; // Host simulation, see host/shim/Arduino.h
+#else
 const uint32_t hardware_ID = (*(RoReg *)0x008061FCUL);
+#endif
 
 /**
  * Global player variables
@@ -58,6 +63,8 @@ bool setupCan(long baudRate)
  */
 void onReceive(int packetSize)
 {
+    PROFILE_ZONE(ZONE_ON_RECEIVE);
+
     if (packetSize) // Only process if we actually received data
     {
         // Dispatch based on the CAN message ID
@@ -83,6 +90,7 @@ void onReceive(int packetSize)
             {
                 Serial.printf("Player %d: %u\n", i + 1, invited_players[i]);
                 if (invited_players[i] == player_ID){
+                    is_dead = false; // Earlier slots marked us as not playing
                     send_GameAck();   
                     break;
                 } else {
@@ -0,0 +1,335 @@
+// Feather-m4-can_bot_example/src/EndgameSolver.cpp
+/**
+ * @file EndgameSolver.cpp
+ * @brief Exact longest path when our head is sealed in a small pocket
+ */
+
+#include "EndgameSolver.h"
+#include <cstring>
+
+namespace
+{
+const uint8_t MAX_CELLS = ENDGAME_MAX_CELLS > 0 ? ENDGAME_MAX_CELLS : 1;
+
+/**
+ * The free cells we can reach, numbered in BFS order from our head
+ */
+struct Pocket
+{
+    uint8_t count;
+    int8_t ox[MAX_CELLS]; // Offset from our head, not wrapped
+    int8_t oy[MAX_CELLS];
+    uint64_t adjacent[MAX_CELLS];
+    uint64_t entry; // Cells next to our head
+    uint64_t dark;  // Cells with odd ox + oy
+};
+
+struct PathSearch
+{
+    const Pocket *pocket;
+    uint32_t nodes;
+    bool aborted;
+    uint8_t limit; // Upper bound at the root, the search stops when a path reaches it
+    uint8_t best;
+    uint8_t path[MAX_CELLS];
+    uint8_t bestPath[MAX_CELLS];
+};
+
+// Cache slot: check = key ^ data, data = length | direction << 8 | cells << 16
+struct CacheSlot
+{
+    uint64_t check;
+    uint64_t data;
+};
+
+CacheSlot cache[ENDGAME_CACHE_SLOTS];
+EndgameStats stats = {0, 0, 0, 0, 0};
+
+inline uint64_t bit(uint8_t index) { return 1ULL << index; }
+
+/**
+ * Collects the pocket around our head
+ *
+ * @return false if an opponent head borders it or it has more than MAX_CELLS cells
+ */
+bool extractPocket(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], uint8_t me, Pocket &pocket)
+{
+    uint64_t visited[GRID_WIDTH] = {0}; // Bit y of word x
+    uint8_t index[GRID_WIDTH * GRID_HEIGHT]; // Pocket index of each visited cell
+    uint8_t cellX[MAX_CELLS];
+    uint8_t cellY[MAX_CELLS];
+
+    pocket.count = 0;
+    pocket.entry = 0;
+    pocket.dark = 0;
+    uint8_t hx = heads[me][0];
+    uint8_t hy = heads[me][1];
+    visited[hx] |= 1ULL << hy;
+
+    // Index MAX_CELLS stands for our head, whose neighbours are the entry cells
+    for (int i = -1; i < (int)pocket.count; i++)
+    {
+        uint8_t x = i < 0 ? hx : cellX[i];
+        uint8_t y = i < 0 ? hy : cellY[i];
+        for (uint8_t dir = 0; dir < 4; dir++)
+        {
+            uint8_t nx = wrapX(x + dx[dir]);
+            uint8_t ny = wrapY(y + dy[dir]);
+            if (grid[nx][ny])
+            {
+                for (uint8_t p = 0; p < NUM_PLAYERS; p++)
+                {
+                    if (p != me && heads[p][0] == nx && heads[p][1] == ny)
+                        return false; // This opponent can still move in
+                }
+                continue;
+            }
+
+            uint8_t j;
+            if (visited[nx] & (1ULL << ny))
+                j = index[nx * GRID_HEIGHT + ny];
+            else
+            {
+                if (pocket.count == MAX_CELLS)
+                    return false;
+                j = pocket.count++;
+                visited[nx] |= 1ULL << ny;
+                index[nx * GRID_HEIGHT + ny] = j;
+                cellX[j] = nx;
+                cellY[j] = ny;
+                pocket.ox[j] = (int8_t)((i < 0 ? 0 : pocket.ox[i]) + dx[dir]);
+                pocket.oy[j] = (int8_t)((i < 0 ? 0 : pocket.oy[i]) + dy[dir]);
+                pocket.adjacent[j] = 0;
+                if ((pocket.ox[j] + pocket.oy[j]) & 1)
+                    pocket.dark |= bit(j);
+            }
+            if (i < 0)
+                pocket.entry |= bit(j);
+            else
+                pocket.adjacent[i] |= bit(j);
+        }
+    }
+    return pocket.count > 0;
+}
+
+/**
+ * Cells reachable from the given ones through free cells, including them
+ */
+uint64_t fill(const Pocket &pocket, uint64_t from, uint64_t free)
+{
+    uint64_t reach = from & free;
+    uint64_t frontier = reach;
+    while (frontier)
+    {
+        uint64_t next = 0;
+        for (uint64_t rest = frontier; rest; rest &= rest - 1)
+            next |= pocket.adjacent[__builtin_ctzll(rest)];
+        frontier = next & free & ~reach;
+        reach |= frontier;
+    }
+    return reach;
+}
+
+/**
+ * Longest path through the reachable cells from a cell of the given colour: it alternates
+ * colours, starting with the other one
+ */
+uint8_t colourBound(const Pocket &pocket, uint64_t reach, bool dark)
+{
+    uint8_t other = (uint8_t)__builtin_popcountll(reach & (dark ? ~pocket.dark : pocket.dark));
+    uint8_t same = (uint8_t)__builtin_popcountll(reach & (dark ? pocket.dark : ~pocket.dark));
+    return other > same ? 2 * same + 1 : 2 * other;
+}
+
+/**
+ * Tries the moves to the given cells, fewest onward moves first
+ */
+void extendPath(PathSearch &search, uint64_t moves, uint64_t free, uint8_t length);
+
+void visit(PathSearch &search, uint8_t cell, uint64_t free, uint8_t length)
+{
+    const Pocket &pocket = *search.pocket;
+    search.path[length - 1] = cell;
+    if (length > search.best)
+    {
+        search.best = length;
+        memcpy(search.bestPath, search.path, length);
+    }
+
+    uint64_t moves = pocket.adjacent[cell] & free;
+    if (!moves)
+        return;
+    uint8_t bound = length + colourBound(pocket, fill(pocket, moves, free), pocket.dark & bit(cell));
+    if (bound > search.best)
+        extendPath(search, moves, free, length);
+}
+
+void extendPath(PathSearch &search, uint64_t moves, uint64_t free, uint8_t length)
+{
+    const Pocket &pocket = *search.pocket;
+    uint8_t order[4];
+    uint8_t degree[4];
+    uint8_t count = 0;
+    for (; moves; moves &= moves - 1)
+    {
+        uint8_t cell = (uint8_t)__builtin_ctzll(moves);
+        uint8_t onward = (uint8_t)__builtin_popcountll(pocket.adjacent[cell] & free & ~bit(cell));
+        uint8_t k = count++;
+        for (; k > 0 && degree[k - 1] > onward; k--)
+        {
+            order[k] = order[k - 1];
+            degree[k] = degree[k - 1];
+        }
+        order[k] = cell;
+        degree[k] = onward;
+    }
+
+    for (uint8_t k = 0; k < count; k++)
+    {
+        if (++search.nodes > ENDGAME_NODE_LIMIT)
+        {
+            search.aborted = true;
+            return;
+        }
+        visit(search, order[k], free & ~bit(order[k]), length + 1);
+        if (search.aborted || search.best == search.limit)
+            return;
+    }
+}
+
+/**
+ * Cache key of the cells in a mask entered from an offset; translation invariant, because
+ * the offsets are taken relative to the bounding box
+ */
+uint64_t pocketKey(const Pocket &pocket, uint64_t cells, int8_t entryX, int8_t entryY)
+{
+    int8_t minX = entryX;
+    int8_t minY = entryY;
+    for (uint64_t rest = cells; rest; rest &= rest - 1)
+    {
+        uint8_t i = (uint8_t)__builtin_ctzll(rest);
+        minX = pocket.ox[i] < minX ? pocket.ox[i] : minX;
+        minY = pocket.oy[i] < minY ? pocket.oy[i] : minY;
+    }
+    uint64_t key = zobristMix(0x200000ULL + (uint64_t)__builtin_popcountll(cells));
+    for (uint64_t rest = cells; rest; rest &= rest - 1)
+    {
+        uint8_t i = (uint8_t)__builtin_ctzll(rest);
+        key ^= zobristMix((uint64_t)(pocket.ox[i] - minX) << 8 | (uint64_t)(pocket.oy[i] - minY));
+    }
+    return key ^ zobristMix(0x10000ULL | (uint64_t)(entryX - minX) << 8 | (uint64_t)(entryY - minY));
+}
+
+bool probeCache(uint64_t key, EndgameResult &result)
+{
+    const CacheSlot &slot = cache[key & (ENDGAME_CACHE_SLOTS - 1)];
+    uint64_t data = slot.data;
+    if ((slot.check ^ data) != key || !data)
+        return false;
+    result.length = (uint8_t)data;
+    result.direction = (uint8_t)(data >> 8);
+    result.cells = (uint8_t)(data >> 16);
+    return true;
+}
+
+void storeCache(uint64_t key, uint8_t length, uint8_t direction, uint8_t cells)
+{
+    CacheSlot &slot = cache[key & (ENDGAME_CACHE_SLOTS - 1)];
+    uint64_t data = (uint64_t)length | (uint64_t)direction << 8 | (uint64_t)cells << 16;
+    slot.check = key ^ data;
+    slot.data = data;
+}
+
+uint8_t directionOf(int dxStep, int dyStep)
+{
+    for (uint8_t dir = 0; dir < 4; dir++)
+    {
+        if (dx[dir] == dxStep && dy[dir] == dyStep)
+            return dir + 1;
+    }
+    return DIR_NONE;
+}
+
+/**
+ * Stores the optimal path and every suffix of it: after k steps the rest of the path is
+ * optimal for the cells still reachable from its k-th cell
+ */
+void cachePath(const Pocket &pocket, const uint8_t path[], uint8_t length, uint64_t all)
+{
+    uint64_t free = all;
+    int8_t fromX = 0;
+    int8_t fromY = 0;
+    uint64_t reach = all;
+    for (uint8_t k = 0; k < length; k++)
+    {
+        uint8_t cell = path[k];
+        uint8_t direction = directionOf(pocket.ox[cell] - fromX, pocket.oy[cell] - fromY);
+        storeCache(pocketKey(pocket, reach, fromX, fromY), length - k, direction,
+                   (uint8_t)__builtin_popcountll(reach));
+        free &= ~bit(cell);
+        fromX = pocket.ox[cell];
+        fromY = pocket.oy[cell];
+        reach = fill(pocket, pocket.adjacent[cell], free);
+    }
+}
+} // namespace
+
+bool solveEndgame(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], uint8_t me, EndgameResult &result)
+{
+    if (ENDGAME_MAX_CELLS == 0 || heads[me][0] == NO_POSITION || heads[me][1] == NO_POSITION)
+        return false;
+
+    Pocket pocket;
+    if (!extractPocket(grid, heads, me, pocket))
+        return false;
+    stats.sealed++;
+
+    uint64_t all = pocket.count == 64 ? ~0ULL : bit(pocket.count) - 1;
+    uint64_t key = pocketKey(pocket, all, 0, 0);
+    if (probeCache(key, result))
+    {
+        result.exact = true;
+        result.cached = true;
+        stats.hits++;
+        return true;
+    }
+
+    PathSearch search;
+    search.pocket = &pocket;
+    search.nodes = 0;
+    search.aborted = false;
+    search.best = 0;
+    search.limit = colourBound(pocket, all, false); // Our head has ox + oy = 0
+    extendPath(search, pocket.entry, all, 0);
+    stats.nodes += search.nodes;
+
+    uint8_t first = search.bestPath[0];
+    result.length = search.best;
+    result.direction = directionOf(pocket.ox[first], pocket.oy[first]);
+    result.cells = pocket.count;
+    result.exact = !search.aborted;
+    result.cached = false;
+    if (search.aborted)
+        stats.aborted++;
+    else
+    {
+        stats.solved++;
+        cachePath(pocket, search.bestPath, search.best, all);
+    }
+    return true;
+}
+
+const EndgameStats &endgameStats()
+{
+    return stats;
+}
+
+void endgameResetStats()
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+void endgameClearCache()
+{
+    memset(cache, 0, sizeof(cache));
+}
@@ -0,0 +1,156 @@
+// Feather-m4-can_bot_example/src/Evaluation.cpp
+/**
+ * @file Evaluation.cpp
+ * @brief One-ply move evaluation from Tactic.md
+ */
+
+#include "Evaluation.h"
+#include "Profiler.h"
+#include <math.h>
+
+/**
+ * "Enough space" cap of the flood fill: regions of at least this many cells all count as this
+ * many, so the other terms decide between them. 0 keeps the exact areas.
+ */
+#ifndef AREA_CAP
+#define AREA_CAP 0
+#endif
+
+namespace
+{
+/**
+ * Score of a free, forward move for a given accessible area
+ */
+float scoreFreeMove(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], uint8_t me, uint8_t heading,
+                    uint8_t direction, int area, const EvalWeights &weights)
+{
+    uint8_t nx = wrapX(heads[me][0] + dx[direction - 1]);
+    uint8_t ny = wrapY(heads[me][1] + dy[direction - 1]);
+
+    float score = weights.space * area;
+
+    // Keep away from the nearest opponent head
+    uint8_t nearest = 0;
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+    {
+        if (i == me || heads[i][0] == NO_POSITION || heads[i][1] == NO_POSITION)
+            continue;
+        uint8_t distance = wrappedDistance(nx, ny, heads[i][0], heads[i][1]);
+        if (nearest == 0 || distance < nearest)
+            nearest = distance;
+    }
+    score += weights.distance * nearest;
+
+    // Hug walls and traces to keep the open space in one piece. The neighbour we come from is
+    // our own head and always blocked, so it does not count.
+    int behind = (direction - 1 + 2) % 4;
+    for (int i = 0; i < 4; i++)
+    {
+        if (i != behind && grid[wrapX(nx + dx[i])][wrapY(ny + dy[i])])
+        {
+            score += weights.wall_bonus;
+            break;
+        }
+    }
+
+    if (direction == heading)
+        score += weights.straight_bonus;
+
+    return score;
+}
+
+/**
+ * Area difference in cells that no other term can make up for. All targets are neighbours of
+ * our head, so their nearest-opponent distances differ by at most 2. The wall and straight
+ * bonuses apply to some targets and not to others, so each can differ by its full weight.
+ *
+ * @return Margin for compareAccessibleAreas(), -1 if the area does not dominate the score
+ */
+int rankingMargin(const EvalWeights &weights)
+{
+    if (weights.space <= 0.0f)
+        return -1;
+    float others = 2.0f * fabsf(weights.distance) + fabsf(weights.wall_bonus) + fabsf(weights.straight_bonus);
+    return (int)(others / weights.space) + 1; // +1 keeps float rounding of the sums out of it
+}
+} // namespace
+
+float evaluateMove(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], uint8_t me, uint8_t heading,
+                   uint8_t direction, const EvalWeights &weights)
+{
+    PROFILE_ZONE(ZONE_EVALUATE_MOVE);
+
+    // The server ignores backwards moves, so this would silently keep the heading
+    if (isReverse(direction, heading))
+        return weights.reversal_penalty;
+
+    uint8_t nx = wrapX(heads[me][0] + dx[direction - 1]);
+    uint8_t ny = wrapY(heads[me][1] + dy[direction - 1]);
+
+    // Check for collision
+    if (grid[nx][ny])
+        return weights.collision_penalty;
+
+    int area = calculateAccessibleArea(grid, nx, ny);
+    if (AREA_CAP > 0 && area > AREA_CAP)
+        area = AREA_CAP;
+    return scoreFreeMove(grid, heads, me, heading, direction, area, weights);
+}
+
+uint8_t chooseMove(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], uint8_t me, uint8_t heading,
+                   const EvalWeights &weights)
+{
+    PROFILE_ZONE(ZONE_EVALUATE_MOVE);
+
+    // Only the ranking matters here, so the free targets share one early-terminating fill
+    float scores[4];
+    uint8_t starts[MAX_FILL_REGIONS][2];
+    uint8_t free_dirs[MAX_FILL_REGIONS];
+    uint8_t free_count = 0;
+    for (uint8_t dir = DIR_UP; dir <= DIR_LEFT; dir++)
+    {
+        uint8_t nx = wrapX(heads[me][0] + dx[dir - 1]);
+        uint8_t ny = wrapY(heads[me][1] + dy[dir - 1]);
+        if (isReverse(dir, heading))
+            scores[dir - 1] = weights.reversal_penalty;
+        else if (grid[nx][ny])
+            scores[dir - 1] = weights.collision_penalty;
+        else
+        {
+            starts[free_count][0] = nx;
+            starts[free_count][1] = ny;
+            free_dirs[free_count++] = dir;
+        }
+    }
+    int areas[MAX_FILL_REGIONS];
+    compareAccessibleAreas(grid, starts, free_count, rankingMargin(weights), AREA_CAP, areas);
+    for (uint8_t k = 0; k < free_count; k++)
+        scores[free_dirs[k] - 1] = scoreFreeMove(grid, heads, me, heading, free_dirs[k], areas[k], weights);
+
+    float best_score = 0.0f;
+    uint8_t best_direction = DIR_NONE;
+
+    for (uint8_t dir = DIR_UP; dir <= DIR_LEFT; dir++)
+    {
+        float score = scores[dir - 1];
+        if (best_direction == DIR_NONE || score > best_score)
+        {
+            best_score = score;
+            best_direction = dir;
+        }
+    }
+
+    // Survival mode: everything looks bad, so just try not to die in the next tick
+    if (best_score < weights.survival_threshold)
+    {
+        for (uint8_t dir = DIR_UP; dir <= DIR_LEFT; dir++)
+        {
+            if (isReverse(dir, heading))
+                continue;
+            if (!grid[wrapX(heads[me][0] + dx[dir - 1])][wrapY(heads[me][1] + dy[dir - 1])])
+                return dir;
+        }
+    }
+
+    return best_direction;
+}
@@ -0,0 +1,183 @@
+// Feather-m4-can_bot_example/src/MemoryWatch.cpp
+/**
+ * @file MemoryWatch.cpp
+ * @brief Stack and heap high-water marks per game tick
+ */
+
+#include "MemoryWatch.h"
+
+#ifdef TRON_MEMWATCH
+
+#include <Arduino.h>
+#include <cstring>
+#include <malloc.h>
+
+#if defined(__arm__)
+extern "C" char *sbrk(int incr);
+#endif
+
+namespace
+{
+const uint32_t PAINT = 0xA5C3A5C3u;
+
+// Distance kept below the current frame when painting (x86-64 red zone, register spills)
+const uintptr_t FRAME_MARGIN = 256;
+
+uintptr_t stack_base = 0;    // Stack depths are measured from here
+uintptr_t window_bottom = 0; // Painted window [window_bottom, window_top)
+uintptr_t window_top = 0;
+uint16_t tick = 0;
+bool warned = false;
+MemoryStats last_tick = {0, 0, 0, 0, 0, false};
+MemoryStats game = {0, 0, 0, 0, 0, false};
+
+/**
+ * @return Address of a local variable, just below the caller's frame
+ */
+__attribute__((noinline)) uintptr_t currentStack()
+{
+    volatile uint32_t marker = 0;
+    return (uintptr_t)&marker;
+}
+
+uintptr_t heapEnd()
+{
+#if defined(__arm__)
+    return (uintptr_t)sbrk(0);
+#else
+    return 0; // The heap is elsewhere in a PC process
+#endif
+}
+
+/**
+ * Lowest address that may be scanned; on the M4 the heap can grow into the window
+ */
+uintptr_t scanBottom()
+{
+    uintptr_t bottom = window_bottom;
+    uintptr_t heap = (heapEnd() + 3) & ~(uintptr_t)3;
+    return heap > bottom ? heap : bottom;
+}
+
+/**
+ * Paints [from, limit) but never the frame of this function or its callers
+ */
+__attribute__((noinline)) void paint(uintptr_t from, uintptr_t limit)
+{
+    uintptr_t below_frame = (currentStack() - FRAME_MARGIN) & ~(uintptr_t)3;
+    if (limit > below_frame)
+        limit = below_frame;
+    // Volatile, so the compiler cannot turn this into a memset call below our frame
+    for (volatile uint32_t *word = (volatile uint32_t *)from; (uintptr_t)word < limit; word++)
+        *word = PAINT;
+}
+
+#if !defined(__arm__)
+/**
+ * Makes the OS map the whole window, so that painting below the stack pointer is safe
+ */
+__attribute__((noinline)) void touchWindow()
+{
+    volatile uint8_t area[STACK_WATCH_WINDOW + 2 * FRAME_MARGIN];
+    for (uint32_t i = 0; i < sizeof(area); i += 1024)
+        area[i] = 0;
+}
+#endif
+
+void readHeap(MemoryStats &stats)
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+    struct mallinfo2 info = mallinfo2();
+#else
+    struct mallinfo info = mallinfo();
+#endif
+    stats.heapInUse = (uint32_t)info.uordblks;
+    stats.heapArena = (uint32_t)info.arena;
+}
+} // namespace
+
+void memoryWatchInit()
+{
+#if defined(__arm__)
+    stack_base = *(const uint32_t *)SCB->VTOR; // Initial stack pointer from the vector table
+#else
+    touchWindow();
+    stack_base = currentStack();
+#endif
+    window_top = (currentStack() - FRAME_MARGIN) & ~(uintptr_t)3;
+    window_bottom = window_top - STACK_WATCH_WINDOW;
+    if (heapEnd() && heapEnd() + FRAME_MARGIN > window_bottom)
+        window_bottom = (heapEnd() + FRAME_MARGIN + 3) & ~(uintptr_t)3; // Smaller window on a small stack
+    paint(window_bottom, window_top);
+
+    tick = 0;
+    warned = false;
+    memset(&game, 0, sizeof(game));
+    game.minGap = UINT32_MAX;
+}
+
+void memoryWatchTick()
+{
+    if (!window_top)
+        return;
+
+    uintptr_t bottom = scanBottom();
+    uintptr_t lowest = bottom;
+    while (lowest < window_top && *(const volatile uint32_t *)lowest == PAINT)
+        lowest += 4;
+
+    last_tick.saturated = lowest == bottom;
+    last_tick.stackPeak = (uint32_t)(stack_base - lowest);
+    last_tick.minGap = heapEnd() ? (uint32_t)(lowest - heapEnd()) : 0;
+    last_tick.peakTick = tick;
+    readHeap(last_tick);
+
+    if (last_tick.stackPeak > game.stackPeak)
+    {
+        game.stackPeak = last_tick.stackPeak;
+        game.peakTick = tick;
+    }
+    if (last_tick.heapInUse > game.heapInUse)
+        game.heapInUse = last_tick.heapInUse;
+    if (last_tick.heapArena > game.heapArena)
+        game.heapArena = last_tick.heapArena;
+    if (heapEnd() && last_tick.minGap < game.minGap)
+        game.minGap = last_tick.minGap;
+    game.saturated = game.saturated || last_tick.saturated;
+
+    if (!warned && (last_tick.saturated || (heapEnd() && last_tick.minGap < STACK_WARN_BYTES)))
+    {
+        Serial.printf("Warning: stack at %lu bytes%s", (unsigned long)last_tick.stackPeak,
+                      last_tick.saturated ? " or more (end of the watched window)" : "");
+        if (heapEnd())
+            Serial.printf(", %lu bytes left above the heap", (unsigned long)last_tick.minGap);
+        Serial.printf("\n");
+        warned = true; // Once per game, the serial output would cost more time than the tick
+    }
+
+    // Only the part used in this tick needs fresh paint
+    paint(lowest, window_top);
+    tick++;
+}
+
+const MemoryStats &memoryWatchLastTick()
+{
+    return last_tick;
+}
+
+void memoryWatchReport()
+{
+    Serial.printf("Memory: stack peak %lu bytes%s at tick %u, heap %lu bytes in use, %lu bytes arena",
+                  (unsigned long)game.stackPeak, game.saturated ? " (window full)" : "", game.peakTick,
+                  (unsigned long)game.heapInUse, (unsigned long)game.heapArena);
+    if (game.minGap != UINT32_MAX)
+        Serial.printf(", closest to heap %lu bytes", (unsigned long)game.minGap);
+    Serial.printf("\n");
+
+    tick = 0;
+    warned = false;
+    memset(&game, 0, sizeof(game));
+    game.minGap = UINT32_MAX;
+}
+
+#endif
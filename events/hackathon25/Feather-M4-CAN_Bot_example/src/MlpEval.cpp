@@ -0,0 +1,246 @@
+// Feather-m4-can_bot_example/src/MlpEval.cpp
+/**
+ * @file MlpEval.cpp
+ * @brief Learned move evaluation: a quantized two-layer perceptron over local board features
+ */
+
+#include "MlpEval.h"
+#include "MlpWeights.h"
+#include "Profiler.h"
+#include <cstring>
+
+#if defined(__ARM_FEATURE_DSP)
+#include <Arduino.h> // CMSIS intrinsics
+#endif
+
+namespace
+{
+#if defined(__ARM_FEATURE_DSP)
+inline int32_t dualMac(uint32_t a, uint32_t b, int32_t acc) { return __SMLAD(a, b, acc); }
+inline uint32_t widenEven(uint32_t bytes) { return __SXTB16(bytes); }
+inline uint32_t widenOdd(uint32_t bytes) { return __SXTB16(__ROR(bytes, 8)); }
+#else
+// The M4 instructions in portable C: SMLAD adds the products of both signed 16-bit lanes,
+// SXTB16 sign-extends bytes 0 and 2 into the two lanes
+inline int32_t dualMac(uint32_t a, uint32_t b, int32_t acc)
+{
+    return acc + (int16_t)a * (int16_t)b + (int16_t)(a >> 16) * (int16_t)(b >> 16);
+}
+inline uint32_t widenEven(uint32_t bytes)
+{
+    return (uint16_t)(int16_t)(int8_t)bytes | ((uint32_t)(uint16_t)(int16_t)(int8_t)(bytes >> 16) << 16);
+}
+inline uint32_t widenOdd(uint32_t bytes) { return widenEven(bytes >> 8); }
+#endif
+
+/**
+ * Packs non-negative int8 values into int16 lanes in the order widenEven()/widenOdd() read
+ * weights: per group of four, (v0, v2) and then (v1, v3)
+ */
+void packLanes(const int8_t values[], uint8_t count, uint32_t packed[])
+{
+    for (uint8_t i = 0; i < count; i += 4)
+    {
+        packed[i / 2] = (uint16_t)values[i] | ((uint32_t)(uint16_t)values[i + 2] << 16);
+        packed[i / 2 + 1] = (uint16_t)values[i + 1] | ((uint32_t)(uint16_t)values[i + 3] << 16);
+    }
+}
+
+int32_t packedDot(const int8_t weights[], const uint32_t packed[], uint8_t count, int32_t acc)
+{
+    for (uint8_t i = 0; i < count; i += 4)
+    {
+        uint32_t bytes;
+        memcpy(&bytes, weights + i, sizeof(bytes)); // One word load, the rows are 4-byte aligned
+        acc = dualMac(widenEven(bytes), packed[i / 2], acc);
+        acc = dualMac(widenOdd(bytes), packed[i / 2 + 1], acc);
+    }
+    return acc;
+}
+
+inline int8_t activate(int32_t acc)
+{
+    acc >>= MLP_SHIFT;
+    return (int8_t)(acc < 0 ? 0 : (acc > MLP_ONE ? MLP_ONE : acc));
+}
+
+inline int8_t saturate(int value)
+{
+    return (int8_t)(value > MLP_ONE ? MLP_ONE : value);
+}
+
+/**
+ * Cells our target cell reaches strictly before every opponent head, by a breadth-first search
+ * from all of them at once. Like the TronCore fills it keeps its buffers on the stack, because
+ * the CAN callback may interrupt a speculative decision in loop().
+ */
+int countTerritory(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], uint8_t me, uint8_t startX, uint8_t startY)
+{
+    // Per cell: owner in the low bits (player + 1, TIE, 0 = not reached) and the BFS level
+    // modulo 3 above, enough to tell a neighbour of the next level from one of the previous
+    const uint8_t OWNER = 0x07;
+    const uint8_t TIE = 0x07;
+    const uint8_t LEVEL_SHIFT = 4;
+    uint8_t reached[GRID_WIDTH * GRID_HEIGHT] = {0};
+    uint16_t queue[GRID_WIDTH * GRID_HEIGHT];
+
+    uint16_t head = 0;
+    uint16_t tail = 0;
+    uint16_t start = startX * GRID_HEIGHT + startY;
+    reached[start] = me + 1;
+    queue[tail++] = start;
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+    {
+        if (i == me || heads[i][0] == NO_POSITION || heads[i][1] == NO_POSITION)
+            continue;
+        uint16_t cell = heads[i][0] * GRID_HEIGHT + heads[i][1];
+        reached[cell] = i + 1;
+        queue[tail++] = cell;
+    }
+
+    int territory = 0;
+    while (head < tail)
+    {
+        uint16_t cell = queue[head++];
+        uint8_t owner = reached[cell] & OWNER;
+        uint8_t level = reached[cell] >> LEVEL_SHIFT;
+        uint8_t nextLevel = (uint8_t)((level + 1) % 3 << LEVEL_SHIFT);
+        if (owner == me + 1)
+            territory++;
+        for (uint8_t dir = 0; dir < 4; dir++)
+        {
+            uint8_t nx = wrapX(cell / GRID_HEIGHT + dx[dir]);
+            uint8_t ny = wrapY(cell % GRID_HEIGHT + dy[dir]);
+            uint16_t next = nx * GRID_HEIGHT + ny;
+            if (grid[nx][ny])
+                continue;
+            if (!reached[next])
+            {
+                reached[next] = nextLevel | owner;
+                queue[tail++] = next;
+            }
+            else if ((reached[next] & OWNER) != owner && (reached[next] & ~OWNER) == nextLevel)
+                reached[next] = nextLevel | TIE; // Reached in the same tick from two sides
+        }
+    }
+    return territory;
+}
+} // namespace
+
+void mlpFeatures(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], uint8_t me, uint8_t heading,
+                 uint8_t direction, int area, int8_t features[MLP_INPUTS])
+{
+    int forwardX = dx[direction - 1];
+    int forwardY = dy[direction - 1];
+    int rightX = -forwardY;
+    int rightY = forwardX;
+    uint8_t tx = wrapX(heads[me][0] + forwardX);
+    uint8_t ty = wrapY(heads[me][1] + forwardY);
+
+    uint8_t k = 0;
+    const int half = MLP_WINDOW / 2;
+    for (int ahead = half; ahead >= -half; ahead--)
+    {
+        for (int right = -half; right <= half; right++)
+        {
+            uint8_t x = wrapX(tx + ahead * forwardX + right * rightX);
+            uint8_t y = wrapY(ty + ahead * forwardY + right * rightY);
+            features[k++] = grid[x][y] ? MLP_ONE : 0;
+        }
+    }
+
+    features[k++] = saturate(area);
+    features[k++] = saturate(area / 32);
+    features[k++] = saturate(countTerritory(grid, heads, me, tx, ty) / 32);
+
+    uint8_t distances[NUM_PLAYERS - 1];
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+    {
+        if (i == me)
+            continue;
+        bool alive = heads[i][0] != NO_POSITION && heads[i][1] != NO_POSITION;
+        uint8_t distance = alive ? wrappedDistance(tx, ty, heads[i][0], heads[i][1]) : GRID_WIDTH;
+        uint8_t j = count++;
+        for (; j > 0 && distances[j - 1] > distance; j--)
+            distances[j] = distances[j - 1];
+        distances[j] = distance;
+    }
+    for (uint8_t i = 0; i < NUM_PLAYERS - 1; i++)
+        features[k++] = saturate(2 * distances[i]);
+
+    features[k++] = direction == heading ? MLP_ONE : 0;
+}
+
+int32_t mlpScore(const int8_t features[MLP_INPUTS])
+{
+    uint32_t inputs[MLP_INPUTS / 2];
+    packLanes(features, MLP_INPUTS, inputs);
+
+    int8_t hidden[MLP_HIDDEN];
+    for (uint8_t h = 0; h < MLP_HIDDEN; h++)
+        hidden[h] = activate(packedDot(MLP_W1[h], inputs, MLP_INPUTS, MLP_B1[h]));
+
+    uint32_t packedHidden[MLP_HIDDEN / 2];
+    packLanes(hidden, MLP_HIDDEN, packedHidden);
+    return packedDot(MLP_W2, packedHidden, MLP_HIDDEN, MLP_B2);
+}
+
+int32_t mlpScoreReference(const int8_t features[MLP_INPUTS])
+{
+    int32_t score = MLP_B2;
+    for (uint8_t h = 0; h < MLP_HIDDEN; h++)
+    {
+        int32_t acc = MLP_B1[h];
+        for (uint8_t i = 0; i < MLP_INPUTS; i++)
+            acc += MLP_W1[h][i] * features[i];
+        score += MLP_W2[h] * activate(acc);
+    }
+    return score;
+}
+
+uint8_t mlpChooseMove(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], uint8_t me, uint8_t heading)
+{
+    PROFILE_ZONE(ZONE_EVALUATE_MOVE);
+
+    uint8_t starts[MAX_FILL_REGIONS][2];
+    uint8_t free_dirs[MAX_FILL_REGIONS];
+    uint8_t free_count = 0;
+    uint8_t fallback = DIR_NONE;
+    for (uint8_t dir = DIR_UP; dir <= DIR_LEFT; dir++)
+    {
+        if (isReverse(dir, heading))
+            continue;
+        if (fallback == DIR_NONE)
+            fallback = dir;
+        uint8_t nx = wrapX(heads[me][0] + dx[dir - 1]);
+        uint8_t ny = wrapY(heads[me][1] + dy[dir - 1]);
+        if (grid[nx][ny])
+            continue;
+        starts[free_count][0] = nx;
+        starts[free_count][1] = ny;
+        free_dirs[free_count++] = dir;
+    }
+    if (!free_count)
+        return fallback;
+    if (free_count == 1)
+        return free_dirs[0];
+
+    int areas[MAX_FILL_REGIONS];
+    compareAccessibleAreas(grid, starts, free_count, -1, 0, areas);
+
+    uint8_t best_direction = DIR_NONE;
+    int32_t best_score = 0;
+    for (uint8_t k = 0; k < free_count; k++)
+    {
+        int8_t features[MLP_INPUTS];
+        mlpFeatures(grid, heads, me, heading, free_dirs[k], areas[k], features);
+        int32_t score = mlpScore(features);
+        if (best_direction == DIR_NONE || score > best_score)
+        {
+            best_score = score;
+            best_direction = free_dirs[k];
+        }
+    }
+    return best_direction;
+}
@@ -0,0 +1,77 @@
+// Feather-m4-can_bot_example/src/OpeningBook.cpp
+/**
+ * @file OpeningBook.cpp
+ * @brief Precomputed moves for the first ticks of every game
+ */
+
+#include <algorithm>
+#include "OpeningBook.h"
+#include "OpeningBookData.h"
+#include "Profiler.h"
+
+namespace
+{
+uint32_t book_key = OPENING_BOOK_ROOT;
+bool in_book = false;
+uint16_t book_moves = 0;
+} // namespace
+
+bool openingBookLookup(uint32_t key, uint8_t &direction)
+{
+    const uint32_t *end = OPENING_BOOK_KEYS + OPENING_BOOK_SIZE;
+    const uint32_t *entry = std::lower_bound(OPENING_BOOK_KEYS, end, key);
+    if (entry == end || *entry != key)
+        return false;
+    uint32_t index = entry - OPENING_BOOK_KEYS;
+    direction = ((OPENING_BOOK_MOVES[index >> 2] >> (2 * (index & 3))) & 3) + 1;
+    return true;
+}
+
+void openingBookStart(const uint8_t heads[NUM_PLAYERS][2])
+{
+    book_key = OPENING_BOOK_ROOT;
+    book_moves = 0;
+    in_book = true;
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+        in_book = in_book && heads[i][0] == SPAWN_X[i] && heads[i][1] == SPAWN_Y[i];
+}
+
+void openingBookFollow(const uint8_t steps[NUM_PLAYERS], uint8_t me)
+{
+    if (!in_book)
+        return;
+    uint8_t ordered[NUM_PLAYERS];
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+    {
+        if (steps[i] == DIR_NONE)
+        {
+            in_book = false;
+            return;
+        }
+        ordered[i ^ me] = steps[i];
+    }
+    book_key = openingBookStep(book_key, ordered);
+}
+
+bool openingBookMove(const Grid &grid, const uint8_t head[2], uint8_t heading, uint8_t &direction)
+{
+    PROFILE_ZONE(ZONE_OPENING_BOOK);
+
+    if (!in_book || !openingBookLookup(book_key, direction))
+    {
+        in_book = false;
+        return false;
+    }
+    if (isReverse(direction, heading) || grid[wrapX(head[0] + dx[direction - 1])][wrapY(head[1] + dy[direction - 1])])
+    {
+        in_book = false;
+        return false;
+    }
+    book_moves++;
+    return true;
+}
+
+uint16_t openingBookMoves()
+{
+    return book_moves;
+}
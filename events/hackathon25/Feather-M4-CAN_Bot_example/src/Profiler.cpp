@@ -0,0 +1,100 @@
+// Feather-m4-can_bot_example/src/Profiler.cpp
+/**
+ * @file Profiler.cpp
+ * @brief Scoped timing zones for finding where the per-tick time goes
+ */
+
+#include "Profiler.h"
+
+#ifdef TRON_PROFILE
+
+#include <cstring>
+
+#ifdef TRON_HOST
+#include <cstdio>
+#define PROFILE_PRINTF printf
+#else
+#include <Arduino.h>
+#define PROFILE_PRINTF Serial.printf
+#endif
+
+ProfileZoneStats profile_zones[ZONE_COUNT];
+PROFILE_THREAD_LOCAL ProfileScope *profile_current = nullptr;
+PROFILE_THREAD_LOCAL uint8_t profile_active[ZONE_COUNT];
+
+namespace
+{
+const char *const ZONE_NAMES[ZONE_COUNT] = {"onReceive",     "GameState",    "openingBook",
+                                            "decideMove",    "search",       "evaluateMove",
+                                            "floodFill",     "compareFill",  "speculation"};
+
+#ifdef TRON_HOST
+inline void add(uint64_t &total, uint64_t value) { __atomic_fetch_add(&total, value, __ATOMIC_RELAXED); }
+inline void add(uint32_t &total, uint32_t value) { __atomic_fetch_add(&total, value, __ATOMIC_RELAXED); }
+inline void raise(uint64_t &maximum, uint64_t value)
+{
+    uint64_t seen = __atomic_load_n(&maximum, __ATOMIC_RELAXED);
+    while (value > seen && !__atomic_compare_exchange_n(&maximum, &seen, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        ;
+}
+#else
+inline void add(uint64_t &total, uint64_t value) { total += value; }
+inline void add(uint32_t &total, uint32_t value) { total += value; }
+inline void raise(uint64_t &maximum, uint64_t value)
+{
+    if (value > maximum)
+        maximum = value;
+}
+#endif
+} // namespace
+
+void profilerRecord(ProfileZone zone, uint64_t inclusive, uint64_t exclusive, bool outermost)
+{
+#if defined(__arm__)
+    // 64-bit adds are not atomic on the M4, and the CAN callback may record the same zone
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+#endif
+    ProfileZoneStats &stats = profile_zones[zone];
+    add(stats.calls, 1);
+    add(stats.exclusive, exclusive);
+    if (outermost)
+    {
+        add(stats.inclusive, inclusive);
+        raise(stats.maxInclusive, inclusive);
+    }
+#if defined(__arm__)
+    __set_PRIMASK(primask);
+#endif
+}
+
+void profilerInit()
+{
+#if defined(__arm__)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    memset(profile_zones, 0, sizeof(profile_zones));
+}
+
+void profilerReport()
+{
+    // Integer microseconds only, the firmware printf has no float support
+    PROFILE_PRINTF("%-13s %9s %11s %11s %9s %9s\n", "Zone", "calls", "incl [us]", "excl [us]", "avg [us]",
+                   "max [us]");
+    for (uint8_t zone = 0; zone < ZONE_COUNT; zone++)
+    {
+        const ProfileZoneStats &stats = profile_zones[zone];
+        if (!stats.calls)
+            continue;
+        PROFILE_PRINTF("%-13s %9lu %11lu %11lu %9lu %9lu\n", ZONE_NAMES[zone], (unsigned long)stats.calls,
+                       (unsigned long)(stats.inclusive / PROFILE_TICKS_PER_US),
+                       (unsigned long)(stats.exclusive / PROFILE_TICKS_PER_US),
+                       (unsigned long)(stats.inclusive / PROFILE_TICKS_PER_US / stats.calls),
+                       (unsigned long)(stats.maxInclusive / PROFILE_TICKS_PER_US));
+    }
+    memset(profile_zones, 0, sizeof(profile_zones));
+}
+
+#endif
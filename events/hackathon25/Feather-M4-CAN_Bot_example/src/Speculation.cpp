@@ -0,0 +1,212 @@
+// Feather-m4-can_bot_example/src/Speculation.cpp
+/**
+ * @file Speculation.cpp
+ * @brief Speculative precomputation of our next move between two game ticks
+ */
+
+#include <Arduino.h>
+#include <cstring>
+#include "Profiler.h"
+#include "Speculation.h"
+
+namespace
+{
+struct Candidate
+{
+    uint8_t heads[NUM_PLAYERS][2];
+    uint8_t headings[NUM_PLAYERS];
+    volatile uint8_t direction; // 0 until evaluated
+};
+
+Grid base;                       // Grid of the current tick, written by the CAN callback only
+Grid scratch;                    // Candidate grid, written by loop() only
+Candidate candidates[MAX_SPECULATIONS];
+volatile uint8_t candidate_count = 0;
+volatile uint8_t next_candidate = 0;
+volatile uint32_t generation = 0;
+SpeculationStats stats = {0, 0, 0, 0, 0, 0};
+} // namespace
+
+void speculationPrepare(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], const uint8_t headings[NUM_PLAYERS],
+                        uint8_t me, uint8_t our_move)
+{
+    generation++;
+    candidate_count = 0;
+    next_candidate = 0;
+
+    // Our own step is known; the server keeps the heading on a backwards move
+    uint8_t our_dir = isReverse(our_move, headings[me]) ? headings[me] : our_move;
+    uint8_t our_x = wrapX(heads[me][0] + dx[our_dir - 1]);
+    uint8_t our_y = wrapY(heads[me][1] + dy[our_dir - 1]);
+    if (grid[our_x][our_y])
+        return; // We die, nothing to precompute
+
+    // Free moves of every opponent, going straight first
+    uint8_t options[NUM_PLAYERS][3];
+    uint8_t option_count[NUM_PLAYERS] = {1, 1, 1, 1};
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+    {
+        options[i][0] = DIR_NONE; // Dead players and we have a single fixed "move"
+        if (i == me || heads[i][0] == NO_POSITION)
+            continue;
+        option_count[i] = 0;
+        for (uint8_t k = 0; k < 4; k++)
+        {
+            uint8_t dir = (headings[i] - 1 + k) % 4 + 1; // Straight, right turn, (reverse), left turn
+            if (isReverse(dir, headings[i]))
+                continue;
+            if (!grid[wrapX(heads[i][0] + dx[dir - 1])][wrapY(heads[i][1] + dy[dir - 1])])
+                options[i][option_count[i]++] = dir;
+        }
+        if (!option_count[i])
+            return; // Somebody dies, the Die message will change the grid anyway
+    }
+
+    memcpy(base, grid, sizeof(Grid));
+
+    // Enumerate all combinations; the rank counts the turns, so fewer turns come first
+    uint8_t ranks[MAX_SPECULATIONS];
+    uint8_t count = 0;
+    uint8_t index[NUM_PLAYERS] = {0, 0, 0, 0};
+    for (;;)
+    {
+        Candidate c;
+        uint8_t rank = 0;
+        bool possible = true;
+        for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+        {
+            uint8_t dir = options[i][index[i]];
+            rank += index[i];
+            if (i == me)
+            {
+                c.heads[i][0] = our_x;
+                c.heads[i][1] = our_y;
+                c.headings[i] = our_dir;
+            }
+            else if (dir == DIR_NONE)
+            {
+                c.heads[i][0] = NO_POSITION;
+                c.heads[i][1] = NO_POSITION;
+                c.headings[i] = headings[i];
+            }
+            else
+            {
+                c.heads[i][0] = wrapX(heads[i][0] + dx[dir - 1]);
+                c.heads[i][1] = wrapY(heads[i][1] + dy[dir - 1]);
+                c.headings[i] = dir;
+            }
+            // Head-on collisions kill both players, which a Die message announces
+            for (uint8_t j = 0; j < i && possible; j++)
+            {
+                possible = c.heads[i][0] == NO_POSITION || c.heads[j][0] != c.heads[i][0] ||
+                           c.heads[j][1] != c.heads[i][1];
+            }
+        }
+        if (possible)
+        {
+            c.direction = 0;
+            // Insertion by rank, keeping the enumeration order for equal ranks
+            uint8_t pos = count;
+            while (pos > 0 && ranks[pos - 1] > rank)
+            {
+                ranks[pos] = ranks[pos - 1];
+                memcpy(&candidates[pos], &candidates[pos - 1], sizeof(Candidate));
+                pos--;
+            }
+            memcpy(&candidates[pos], &c, sizeof(Candidate));
+            ranks[pos] = rank;
+            count++;
+        }
+
+        uint8_t i = 0;
+        while (i < NUM_PLAYERS && ++index[i] >= option_count[i])
+            index[i++] = 0;
+        if (i == NUM_PLAYERS)
+            break;
+    }
+
+    candidate_count = count;
+    stats.prepared += count;
+}
+
+bool speculationLookup(const uint8_t heads[NUM_PLAYERS][2], uint8_t &direction)
+{
+    uint8_t count = candidate_count;
+    candidate_count = 0; // Only valid for this tick
+    next_candidate = 0;
+    generation++;
+
+    if (!count)
+    {
+        stats.skipped++;
+        return false;
+    }
+    for (uint8_t k = 0; k < count; k++)
+    {
+        if (memcmp(candidates[k].heads, heads, sizeof(candidates[k].heads)))
+            continue;
+        if (!candidates[k].direction)
+        {
+            stats.notReady++;
+            return false;
+        }
+        direction = candidates[k].direction;
+        stats.hits++;
+        return true;
+    }
+    stats.misses++;
+    return false;
+}
+
+void speculationInvalidate()
+{
+    generation++;
+    candidate_count = 0;
+    next_candidate = 0;
+}
+
+bool speculationStep(MoveDecider decide)
+{
+    Candidate candidate;
+    noInterrupts();
+    uint32_t gen = generation;
+    uint8_t k = next_candidate;
+    bool pending = k < candidate_count;
+    if (pending)
+    {
+        next_candidate = k + 1;
+        memcpy(&candidate, &candidates[k], sizeof(Candidate));
+    }
+    interrupts();
+    if (!pending)
+        return false;
+    PROFILE_ZONE(ZONE_SPECULATION);
+
+    // If the callback rewrites base meanwhile, the generation check below drops the result
+    memcpy(scratch, base, sizeof(Grid));
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+    {
+        if (candidate.heads[i][0] != NO_POSITION)
+            scratch[candidate.heads[i][0]][candidate.heads[i][1]] = i + 1;
+    }
+    uint8_t direction = decide(scratch, candidate.heads, candidate.headings);
+
+    noInterrupts();
+    if (gen == generation && direction)
+    {
+        candidates[k].direction = direction;
+        stats.evaluated++;
+    }
+    interrupts();
+    return true;
+}
+
+const SpeculationStats &speculationStats()
+{
+    return stats;
+}
+
+void speculationResetStats()
+{
+    memset(&stats, 0, sizeof(stats));
+}
@@ -0,0 +1,277 @@
+// Feather-m4-can_bot_example/src/TronCore.cpp
+/**
+ * @file TronCore.cpp
+ * @brief Board model and game rules shared by the firmware and host builds
+ */
+
+#include "TronCore.h"
+#include "Profiler.h"
+#include <cstring>
+
+uint8_t directionBetween(uint8_t fromX, uint8_t fromY, uint8_t toX, uint8_t toY)
+{
+    for (uint8_t dir = DIR_UP; dir <= DIR_LEFT; dir++)
+    {
+        if (wrapX(fromX + dx[dir - 1]) == toX && wrapY(fromY + dy[dir - 1]) == toY)
+            return dir;
+    }
+    return DIR_NONE;
+}
+
+uint8_t wrappedDistance(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2)
+{
+    int ddx = x1 > x2 ? x1 - x2 : x2 - x1;
+    int ddy = y1 > y2 ? y1 - y2 : y2 - y1;
+    if (ddx > GRID_WIDTH - ddx)
+        ddx = GRID_WIDTH - ddx;
+    if (ddy > GRID_HEIGHT - ddy)
+        ddy = GRID_HEIGHT - ddy;
+    return (uint8_t)(ddx + ddy);
+}
+
+void initTronState(TronState &state)
+{
+    memset(state.grid, 0, sizeof(state.grid));
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+    {
+        state.x[i] = SPAWN_X[i];
+        state.y[i] = SPAWN_Y[i];
+        state.heading[i] = DIR_UP;
+        state.grid[SPAWN_X[i]][SPAWN_Y[i]] = i + 1;
+    }
+    state.alive = (1 << NUM_PLAYERS) - 1;
+    state.hash = computeHash(state);
+}
+
+uint64_t computeHash(const TronState &state)
+{
+    uint64_t hash = 0;
+    for (uint8_t x = 0; x < GRID_WIDTH; x++)
+    {
+        for (uint8_t y = 0; y < GRID_HEIGHT; y++)
+        {
+            if (state.grid[x][y])
+                hash ^= zobristCellKey(x, y, state.grid[x][y]);
+        }
+    }
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+    {
+        if (state.alive & (1 << i))
+            hash ^= zobristHeadKey(i, state.x[i], state.y[i], state.heading[i]);
+    }
+    return hash;
+}
+
+uint8_t applyMoves(TronState &state, const uint8_t moves[NUM_PLAYERS])
+{
+    uint8_t nextX[NUM_PLAYERS];
+    uint8_t nextY[NUM_PLAYERS];
+    uint8_t nextHeading[NUM_PLAYERS];
+    uint8_t died = 0;
+
+    // Everybody moves at the same time; collisions are checked against the old grid
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+    {
+        if (!(state.alive & (1 << i)))
+            continue;
+
+        uint8_t dir = moves[i];
+        if (dir < DIR_UP || dir > DIR_LEFT || isReverse(dir, state.heading[i]))
+            dir = state.heading[i]; // The server ignores invalid and backwards moves
+
+        nextHeading[i] = dir;
+        nextX[i] = wrapX(state.x[i] + dx[dir - 1]);
+        nextY[i] = wrapY(state.y[i] + dy[dir - 1]);
+
+        if (state.grid[nextX[i]][nextY[i]])
+            died |= 1 << i;
+    }
+
+    // Head-on collisions: both players die
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+    {
+        if (!(state.alive & (1 << i)))
+            continue;
+        for (uint8_t j = i + 1; j < NUM_PLAYERS; j++)
+        {
+            if ((state.alive & (1 << j)) && nextX[i] == nextX[j] && nextY[i] == nextY[j])
+                died |= (1 << i) | (1 << j);
+        }
+    }
+
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+    {
+        if (!(state.alive & (1 << i)))
+            continue;
+
+        state.hash ^= zobristHeadKey(i, state.x[i], state.y[i], state.heading[i]);
+        if (died & (1 << i))
+        {
+            state.x[i] = NO_POSITION;
+            state.y[i] = NO_POSITION;
+            continue;
+        }
+
+        state.x[i] = nextX[i];
+        state.y[i] = nextY[i];
+        state.heading[i] = nextHeading[i];
+        state.grid[nextX[i]][nextY[i]] = i + 1;
+        state.hash ^= zobristCellKey(nextX[i], nextY[i], i + 1);
+        state.hash ^= zobristHeadKey(i, nextX[i], nextY[i], nextHeading[i]);
+    }
+
+    // Only after all deaths of this tick are known, the traces of the dead disappear
+    if (died)
+    {
+        state.alive &= ~died;
+        for (uint8_t x = 0; x < GRID_WIDTH; x++)
+        {
+            for (uint8_t y = 0; y < GRID_HEIGHT; y++)
+            {
+                uint8_t owner = state.grid[x][y];
+                if (owner && (died & (1 << (owner - 1))))
+                {
+                    state.hash ^= zobristCellKey(x, y, owner);
+                    state.grid[x][y] = 0;
+                }
+            }
+        }
+    }
+
+    return died;
+}
+
+int calculateAccessibleArea(const Grid &grid, uint8_t x, uint8_t y)
+{
+    PROFILE_ZONE(ZONE_FLOOD_FILL);
+
+    // Every cell enters the queue at most once, so a fixed array replaces std::queue and the
+    // fill never touches the heap (it also runs in the CAN callback)
+    uint32_t visited[GRID_WIDTH * GRID_HEIGHT / 32] = {0};
+    uint16_t queue[GRID_WIDTH * GRID_HEIGHT];
+    uint16_t head = 0;
+    uint16_t tail = 0;
+
+    uint16_t start = x * GRID_HEIGHT + y;
+    queue[tail++] = start;
+    visited[start >> 5] |= 1UL << (start & 31);
+
+    while (head < tail)
+    {
+        uint16_t cell = queue[head++];
+        uint8_t cx = cell / GRID_HEIGHT;
+        uint8_t cy = cell % GRID_HEIGHT;
+
+        for (int i = 0; i < 4; i++)
+        {
+            uint8_t nx = wrapX(cx + dx[i]);
+            uint8_t ny = wrapY(cy + dy[i]);
+            uint16_t next = nx * GRID_HEIGHT + ny;
+
+            if (!(visited[next >> 5] & (1UL << (next & 31))) && !grid[nx][ny])
+            {
+                visited[next >> 5] |= 1UL << (next & 31);
+                queue[tail++] = next;
+            }
+        }
+    }
+
+    return tail;
+}
+
+void compareAccessibleAreas(const Grid &grid, const uint8_t starts[][2], uint8_t count, int margin, int cap,
+                            int areas[])
+{
+    PROFILE_ZONE(ZONE_COMPARE_FILL);
+
+    // One multi-source BFS: every cell belongs to the region that reached it first, and the
+    // queue keeps all regions growing at the same speed
+    uint8_t label[GRID_WIDTH * GRID_HEIGHT] = {0}; // Start index + 1, 0 = not reached
+    uint16_t queue[GRID_WIDTH * GRID_HEIGHT];
+    uint16_t head = 0;
+    uint16_t tail = 0;
+
+    // Regions that touch are one component; root[] merges them, size and pending live at the root
+    uint8_t root[MAX_FILL_REGIONS];
+    int size[MAX_FILL_REGIONS];
+    int pending[MAX_FILL_REGIONS]; // Queued cells not expanded yet, 0 = region complete
+
+    for (uint8_t r = 0; r < count; r++)
+    {
+        uint16_t start = starts[r][0] * GRID_HEIGHT + starts[r][1];
+        root[r] = r;
+        size[r] = 1;
+        pending[r] = 1;
+        label[start] = r + 1;
+        queue[tail++] = start;
+    }
+
+    auto find = [&](uint8_t r) {
+        while (root[r] != r)
+            r = root[r];
+        return r;
+    };
+    auto value = [&](uint8_t r) { return cap > 0 && size[r] >= cap ? cap : size[r]; };
+
+    while (head < tail)
+    {
+        // Ranking decided: all regions but one are complete (or capped), and the remaining one
+        // is already more than margin cells larger than all others
+        uint8_t growing = 0;
+        uint8_t open = MAX_FILL_REGIONS;
+        int largest_closed = -1;
+        for (uint8_t r = 0; r < count; r++)
+        {
+            if (root[r] != r)
+                continue;
+            if (pending[r] && (cap <= 0 || size[r] < cap))
+            {
+                growing++;
+                open = r;
+            }
+            else if (value(r) > largest_closed)
+                largest_closed = value(r);
+        }
+        if (growing == 0 || (growing == 1 && margin >= 0 && size[open] > largest_closed + margin))
+            break;
+
+        uint16_t cell = queue[head++];
+        uint8_t r = find(label[cell] - 1);
+        pending[r]--;
+        if (cap > 0 && size[r] >= cap)
+            continue; // Enough space, only merges can still change this region
+
+        uint8_t cx = cell / GRID_HEIGHT;
+        uint8_t cy = cell % GRID_HEIGHT;
+        for (int i = 0; i < 4; i++)
+        {
+            uint8_t nx = wrapX(cx + dx[i]);
+            uint8_t ny = wrapY(cy + dy[i]);
+            uint16_t next = nx * GRID_HEIGHT + ny;
+            if (grid[nx][ny])
+                continue;
+
+            if (!label[next])
+            {
+                label[next] = r + 1;
+                queue[tail++] = next;
+                size[r]++;
+                pending[r]++;
+            }
+            else
+            {
+                uint8_t other = find(label[next] - 1);
+                if (other != r)
+                {
+                    // Same component: both regions end up with the same area
+                    root[other] = r;
+                    size[r] += size[other];
+                    pending[r] += pending[other];
+                }
+            }
+        }
+    }
+
+    for (uint8_t r = 0; r < count; r++)
+        areas[r] = value(find(r));
+}
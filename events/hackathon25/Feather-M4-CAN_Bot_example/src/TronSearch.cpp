@@ -0,0 +1,404 @@
+// Feather-m4-can_bot_example/src/TronSearch.cpp
+/**
+ * @file TronSearch.cpp
+ * @brief Depth-limited game search over simultaneous 4-player moves
+ */
+
+#include "TronSearch.h"
+#include <cstring>
+
+namespace
+{
+const float SCORE_INFINITY = 1.0e9f;
+
+#ifdef TRON_HOST
+inline uint64_t loadWord(const TranspositionTable::Word &word) { return word.load(std::memory_order_relaxed); }
+inline void storeWord(TranspositionTable::Word &word, uint64_t value) { word.store(value, std::memory_order_relaxed); }
+#else
+inline uint64_t loadWord(const TranspositionTable::Word &word) { return word; }
+inline void storeWord(TranspositionTable::Word &word, uint64_t value) { word = value; }
+#endif
+
+inline uint64_t packEntry(const TTEntry &entry)
+{
+    uint32_t scoreBits;
+    memcpy(&scoreBits, &entry.score, sizeof(scoreBits));
+    return (uint64_t)scoreBits | ((uint64_t)entry.depth << 32) | ((uint64_t)entry.bound << 40) |
+           ((uint64_t)entry.move << 48);
+}
+
+inline TTEntry unpackEntry(uint64_t data)
+{
+    TTEntry entry;
+    uint32_t scoreBits = (uint32_t)data;
+    memcpy(&entry.score, &scoreBits, sizeof(scoreBits));
+    entry.depth = (uint8_t)(data >> 32);
+    entry.bound = (uint8_t)(data >> 40);
+    entry.move = (uint8_t)(data >> 48);
+    return entry;
+}
+
+static_assert(GRID_HEIGHT == 64, "evaluateLeaf keeps one board column in a 64-bit word");
+static_assert(BOARD_MAX_PLIES >= SEARCH_MAX_DEPTH, "the search makes up to SEARCH_MAX_DEPTH ticks on one Board");
+
+// The move generators read a position through these, so they serve TronState and Board alike
+inline uint8_t headingOf(const TronState &state, uint8_t player) { return state.heading[player]; }
+inline uint8_t headingOf(const Board &board, uint8_t player) { return board.heading(player); }
+inline uint8_t aliveOf(const TronState &state) { return state.alive; }
+inline uint8_t aliveOf(const Board &board) { return board.alive(); }
+inline uint8_t xOf(const TronState &state, uint8_t player) { return state.x[player]; }
+inline uint8_t xOf(const Board &board, uint8_t player) { return board.x(player); }
+inline uint8_t yOf(const TronState &state, uint8_t player) { return state.y[player]; }
+inline uint8_t yOf(const Board &board, uint8_t player) { return board.y(player); }
+
+inline bool isFree(const TronState &state, uint8_t player, uint8_t dir)
+{
+    return !state.grid[wrapX(state.x[player] + dx[dir - 1])][wrapY(state.y[player] + dy[dir - 1])];
+}
+
+inline bool isFree(const Board &board, uint8_t player, uint8_t dir)
+{
+    return board.isFree(wrapX(board.x(player) + dx[dir - 1]), wrapY(board.y(player) + dy[dir - 1]));
+}
+
+/**
+ * Move of an opponent that is not searched: keep going straight unless that is fatal
+ */
+template <typename Position>
+uint8_t defaultMove(const Position &position, uint8_t player)
+{
+    uint8_t heading = headingOf(position, player);
+    if (isFree(position, player, heading))
+        return heading;
+    for (uint8_t dir = DIR_UP; dir <= DIR_LEFT; dir++)
+    {
+        if (!isReverse(dir, heading) && isFree(position, player, dir))
+            return dir;
+    }
+    return heading;
+}
+
+template <typename Position>
+uint8_t generateOurMovesOf(const Position &position, uint8_t me, uint8_t ttMove, uint8_t moves[MAX_OUR_MOVES])
+{
+    uint8_t heading = headingOf(position, me);
+    uint8_t count = 0;
+    if (ttMove != DIR_NONE && !isReverse(ttMove, heading))
+        moves[count++] = ttMove;
+
+    // Straight ahead first, it keeps the most options open in the common case
+    if (heading != ttMove)
+        moves[count++] = heading;
+    for (uint8_t dir = DIR_UP; dir <= DIR_LEFT; dir++)
+    {
+        if (dir != heading && dir != ttMove && !isReverse(dir, heading))
+            moves[count++] = dir;
+    }
+    return count;
+}
+
+template <typename Position>
+uint8_t generateRepliesOf(const Position &position, uint8_t me, uint8_t depth,
+                          uint8_t replies[MAX_REPLIES][NUM_PLAYERS])
+{
+    uint8_t options[NUM_PLAYERS][MAX_OUR_MOVES];
+    uint8_t optionCount[NUM_PLAYERS];
+
+    for (uint8_t i = 0; i < NUM_PLAYERS; i++)
+    {
+        optionCount[i] = 1;
+        options[i][0] = DIR_NONE;
+        if (i == me || !(aliveOf(position) & (1 << i)))
+            continue;
+
+        // Only opponents that can reach the cells around our head within the horizon branch
+        if (wrappedDistance(xOf(position, i), yOf(position, i), xOf(position, me), yOf(position, me)) > 2 * depth + 1)
+        {
+            options[i][0] = defaultMove(position, i);
+            continue;
+        }
+
+        optionCount[i] = 0;
+        uint8_t heading = headingOf(position, i);
+        for (uint8_t dir = DIR_UP; dir <= DIR_LEFT; dir++)
+        {
+            if (!isReverse(dir, heading) && isFree(position, i, dir))
+                options[i][optionCount[i]++] = dir;
+        }
+        if (optionCount[i] == 0)
+        {
+            options[i][0] = heading; // Dead anyway, one reply is enough
+            optionCount[i] = 1;
+        }
+    }
+
+    uint8_t count = 0;
+    for (uint8_t a = 0; a < optionCount[0]; a++)
+        for (uint8_t b = 0; b < optionCount[1]; b++)
+            for (uint8_t c = 0; c < optionCount[2]; c++)
+                for (uint8_t d = 0; d < optionCount[3]; d++)
+                {
+                    replies[count][0] = options[0][a];
+                    replies[count][1] = options[1][b];
+                    replies[count][2] = options[2][c];
+                    replies[count][3] = options[3][d];
+                    count++;
+                }
+    return count;
+}
+
+inline uint64_t rotateUp(uint64_t column, unsigned bits) { return (column >> bits) | (column << (64 - bits)); }
+inline uint64_t rotateDown(uint64_t column, unsigned bits) { return (column << bits) | (column >> (64 - bits)); }
+
+/**
+ * Extends the reached cells of a column along its free runs, across the wrap at the edge.
+ * Kogge-Stone fill: after step k a cell is reached if a reached cell lies up to 2^k - 1 free
+ * cells away, so six steps cover the whole column.
+ */
+uint64_t fillColumn(uint64_t reached, uint64_t free)
+{
+    uint64_t up = reached;
+    uint64_t down = reached;
+    uint64_t upFree = free;
+    uint64_t downFree = free;
+    for (unsigned bits = 1; bits < 64; bits <<= 1)
+    {
+        up |= upFree & rotateDown(up, bits);
+        upFree &= rotateDown(upFree, bits);
+        down |= downFree & rotateUp(down, bits);
+        downFree &= rotateUp(downFree, bits);
+    }
+    return up | down;
+}
+} // namespace
+
+TranspositionTable::TranspositionTable(Slot *slots, size_t count)
+    : slots_(slots), mask_(count - 1)
+{
+    clear();
+}
+
+bool TranspositionTable::probe(uint64_t key, TTEntry &entry) const
+{
+    const Slot &slot = slots_[key & mask_];
+    uint64_t data = loadWord(slot.data);
+    if ((loadWord(slot.check) ^ data) != key)
+        return false;
+    entry = unpackEntry(data);
+    return entry.bound != TT_NONE;
+}
+
+void TranspositionTable::store(uint64_t key, const TTEntry &entry)
+{
+    Slot &slot = slots_[key & mask_];
+    uint64_t old = loadWord(slot.data);
+    // Depth-preferred replacement, but always overwrite entries of other positions
+    if ((loadWord(slot.check) ^ old) == key && unpackEntry(old).depth > entry.depth)
+        return;
+    uint64_t data = packEntry(entry);
+    storeWord(slot.check, key ^ data);
+    storeWord(slot.data, data);
+}
+
+void TranspositionTable::clear()
+{
+    for (size_t i = 0; i <= mask_; i++)
+    {
+        storeWord(slots_[i].check, 0);
+        storeWord(slots_[i].data, 0);
+    }
+}
+
+uint8_t generateOurMoves(const TronState &state, uint8_t me, uint8_t ttMove, uint8_t moves[MAX_OUR_MOVES])
+{
+    return generateOurMovesOf(state, me, ttMove, moves);
+}
+
+uint8_t generateOurMoves(const Board &board, uint8_t me, uint8_t ttMove, uint8_t moves[MAX_OUR_MOVES])
+{
+    return generateOurMovesOf(board, me, ttMove, moves);
+}
+
+uint8_t generateReplies(const TronState &state, uint8_t me, uint8_t depth, uint8_t replies[MAX_REPLIES][NUM_PLAYERS])
+{
+    return generateRepliesOf(state, me, depth, replies);
+}
+
+uint8_t generateReplies(const Board &board, uint8_t me, uint8_t depth, uint8_t replies[MAX_REPLIES][NUM_PLAYERS])
+{
+    return generateRepliesOf(board, me, depth, replies);
+}
+
+float evaluateLeaf(const TronState &state, uint8_t me)
+{
+    return (float)calculateAccessibleArea(state.grid, state.x[me], state.y[me]);
+}
+
+float evaluateLeaf(const Board &board, uint8_t me)
+{
+    // Same cells as calculateAccessibleArea: the head plus every free cell connected to it.
+    // Sweeps alternate direction so open areas settle in a few passes.
+    uint64_t reached[GRID_WIDTH] = {0};
+    reached[board.x(me)] = 1ULL << board.y(me);
+    bool changed = true;
+    for (bool forward = true; changed; forward = !forward)
+    {
+        changed = false;
+        for (int i = 0; i < GRID_WIDTH; i++)
+        {
+            uint8_t x = forward ? i : GRID_WIDTH - 1 - i;
+            uint64_t free = ~board.column(x);
+            uint64_t seed = reached[x] | ((reached[wrapX(x - 1)] | reached[wrapX(x + 1)]) & free);
+            uint64_t column = fillColumn(seed, free);
+            if (column != reached[x])
+            {
+                reached[x] = column;
+                changed = true;
+            }
+        }
+    }
+
+    int area = 0;
+    for (int x = 0; x < GRID_WIDTH; x++)
+        area += __builtin_popcountll(reached[x]);
+    return (float)area;
+}
+
+float searchValue(SearchContext &context, Board &board, uint8_t depth, float alpha, float beta)
+{
+    context.nodes++;
+    const uint8_t me = context.me;
+
+    // Dying sooner is worse, winning sooner is better
+    if (!(board.alive() & (1 << me)))
+        return SCORE_LOSS - depth;
+    if (board.alive() == (1 << me))
+        return SCORE_WIN + depth;
+    if (depth == 0)
+        return evaluateLeaf(board, me);
+
+    const float alphaOrig = alpha;
+    uint8_t ttMove = DIR_NONE;
+    TTEntry entry;
+    if (context.tt && context.tt->probe(searchKey(board, me), entry))
+    {
+        ttMove = entry.move;
+        if (entry.depth == depth)
+        {
+            if (entry.bound == TT_EXACT)
+                return entry.score;
+            if (entry.bound == TT_LOWER && entry.score >= beta)
+                return entry.score;
+            if (entry.bound == TT_UPPER && entry.score <= alpha)
+                return entry.score;
+        }
+    }
+
+    uint8_t moves[MAX_OUR_MOVES];
+    uint8_t moveCount = generateOurMoves(board, me, ttMove, moves);
+    uint8_t replies[MAX_REPLIES][NUM_PLAYERS];
+    uint8_t replyCount = generateReplies(board, me, depth, replies);
+
+    float best = -SCORE_INFINITY;
+    uint8_t bestMove = moves[0];
+
+    for (uint8_t m = 0; m < moveCount; m++)
+    {
+        // The opponents minimize over their joint replies to our move
+        float worst = SCORE_INFINITY;
+        float floor = best > alpha ? best : alpha;
+        for (uint8_t r = 0; r < replyCount; r++)
+        {
+            replies[r][me] = moves[m];
+            board.make(replies[r]);
+            float value = searchValue(context, board, depth - 1, floor, worst < beta ? worst : beta);
+            board.unmake();
+
+            if (value < worst)
+                worst = value;
+            if (worst <= floor)
+                break; // This move cannot beat the best one found so far
+        }
+
+        if (worst > best)
+        {
+            best = worst;
+            bestMove = moves[m];
+        }
+        if (best >= beta)
+            break;
+    }
+
+    if (context.tt)
+    {
+        entry.score = best;
+        entry.depth = depth;
+        entry.bound = best <= alphaOrig ? TT_UPPER : (best >= beta ? TT_LOWER : TT_EXACT);
+        entry.move = bestMove;
+        context.tt->store(searchKey(board, me), entry);
+    }
+    return best;
+}
+
+float searchValue(SearchContext &context, const TronState &state, uint8_t depth, float alpha, float beta)
+{
+    Board board;
+    board.init(state);
+    return searchValue(context, board, depth, alpha, beta);
+}
+
+SearchResult searchBestMove(const TronState &state, uint8_t me, uint8_t depth, TranspositionTable *tt)
+{
+    SearchResult result = {DIR_NONE, SCORE_LOSS, 0};
+    if (!(state.alive & (1 << me)))
+        return result;
+
+    SearchContext context = {me, tt, 0};
+    if (depth > SEARCH_MAX_DEPTH)
+        depth = SEARCH_MAX_DEPTH;
+
+    Board board;
+    board.init(state);
+
+    // Iterative deepening: shallow iterations fill the table with good move orderings
+    uint8_t first = tt ? 1 : depth;
+    for (uint8_t d = first; d <= depth; d++)
+    {
+        uint8_t ttMove = result.direction;
+        uint8_t moves[MAX_OUR_MOVES];
+        uint8_t moveCount = generateOurMoves(board, me, ttMove, moves);
+        uint8_t replies[MAX_REPLIES][NUM_PLAYERS];
+        uint8_t replyCount = generateReplies(board, me, d, replies);
+
+        float best = -SCORE_INFINITY;
+        uint8_t bestMove = moves[0];
+
+        for (uint8_t m = 0; m < moveCount; m++)
+        {
+            float worst = SCORE_INFINITY;
+            for (uint8_t r = 0; r < replyCount; r++)
+            {
+                replies[r][me] = moves[m];
+                board.make(replies[r]);
+                float value = searchValue(context, board, d - 1, best, worst);
+                board.unmake();
+
+                if (value < worst)
+                    worst = value;
+                if (worst <= best)
+                    break;
+            }
+            if (worst > best)
+            {
+                best = worst;
+                bestMove = moves[m];
+            }
+        }
+
+        result.direction = bestMove;
+        result.score = best;
+    }
+
+    result.nodes = context.nodes;
+    return result;
+}
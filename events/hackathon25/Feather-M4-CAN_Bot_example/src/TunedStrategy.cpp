@@ -0,0 +1,193 @@
+// Feather-m4-can_bot_example/src/TunedStrategy.cpp
+/**
+ * @file TunedStrategy.cpp
+ * @brief The main bot: opening book, speculation, endgame solver and the tuned evaluation
+ */
+
+#include "TunedStrategy.h"
+#include "EndgameSolver.h"
+#include "Evaluation.h"
+#include "Hackathon25.h"
+#include "MlpEval.h"
+#include "OpeningBook.h"
+#include "Profiler.h"
+#include "Speculation.h"
+#include "TronSearch.h"
+#include "TunedWeights.h"
+#include <Arduino.h>
+#include <cstring>
+
+#ifdef TRON_HOST
+#include <thread>
+#include "ParallelSearch.h"
+#endif
+
+/**
+ * Look-ahead of the game search in ticks; 0 keeps the one-ply flood fill evaluation.
+ * Host builds set it through build_flags, e.g. -DSEARCH_DEPTH=4.
+ */
+#ifndef SEARCH_DEPTH
+#define SEARCH_DEPTH 0
+#endif
+
+// Search threads in host builds, 0 = one per hardware thread
+#ifndef SEARCH_THREADS
+#define SEARCH_THREADS 0
+#endif
+
+// Transposition table slots in firmware builds (16 bytes each)
+#ifndef SEARCH_TT_SLOTS
+#define SEARCH_TT_SLOTS 1024
+#endif
+
+/**
+ * Replaces the one-ply evaluation with the quantized move network (include/MlpEval.h) when
+ * SEARCH_DEPTH is 0. Weights come from host/mlp_train.cpp. Experimental: the network does not
+ * beat chooseMove() and is much slower, see MlpEval.h.
+ */
+#ifndef MLP_EVAL
+#define MLP_EVAL 0
+#endif
+
+namespace
+{
+#if SEARCH_DEPTH > 0
+/**
+ * Runs the game search on a grid.
+ * Host builds distribute it over all cores, the firmware searches on the calling thread.
+ *
+ * @param board Grid with all heads marked
+ * @param heads Head positions, NO_POSITION for dead players
+ * @param headings Last step direction of every player
+ * @param state Search state buffer; the CAN callback and loop() each use their own
+ * @return Best direction, 0 if no move was found
+ */
+uint8_t searchMove(const Grid &board, const uint8_t heads[4][2], const uint8_t headings[4], TronState &state)
+{
+    PROFILE_ZONE(ZONE_SEARCH);
+
+    memcpy(state.grid, board, sizeof(Grid));
+    state.alive = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        state.x[i] = heads[i][0];
+        state.y[i] = heads[i][1];
+        state.heading[i] = headings[i];
+        if (state.x[i] != NO_POSITION && state.y[i] != NO_POSITION)
+            state.alive |= 1 << i;
+    }
+    state.hash = computeHash(state);
+
+#ifdef TRON_HOST
+    static WorkStealingPool pool(SEARCH_THREADS ? SEARCH_THREADS : std::thread::hardware_concurrency());
+    static HostTranspositionTable tt(20);
+    SearchResult result = searchParallel(pool, state, player_ID - 1, SEARCH_DEPTH, &tt);
+#else
+    static TranspositionTable::Slot tt_slots[SEARCH_TT_SLOTS];
+    static TranspositionTable tt(tt_slots, SEARCH_TT_SLOTS); // Shared, entries are verified on every probe
+    SearchResult result = searchBestMove(state, player_ID - 1, SEARCH_DEPTH, &tt);
+#endif
+    return result.direction;
+}
+#endif
+
+/**
+ * Picks our move on a grid with the game search or the one-ply evaluation.
+ *
+ * @param speculative true when called from loop() for a predicted grid
+ * @return Best direction, 0 if no move was found
+ */
+uint8_t decideMove(const Grid &board, const uint8_t heads[4][2], const uint8_t headings[4], bool speculative)
+{
+    PROFILE_ZONE(ZONE_DECIDE_MOVE);
+
+    // Sealed in a small pocket, only our own path matters (-DENDGAME_MAX_CELLS=0 turns it off)
+    EndgameResult endgame;
+    if (solveEndgame(board, heads, player_ID - 1, endgame))
+        return endgame.direction;
+
+#if SEARCH_DEPTH > 0
+    static TronState live_state;        // 4 KB each, kept off the stack
+    static TronState speculative_state;
+    return searchMove(board, heads, headings, speculative ? speculative_state : live_state);
+#else
+    (void)speculative;
+#if MLP_EVAL
+    return mlpChooseMove(board, heads, player_ID - 1, headings[player_ID - 1]);
+#else
+    return chooseMove(board, heads, player_ID - 1, headings[player_ID - 1], TUNED_WEIGHTS);
+#endif
+#endif
+}
+
+uint8_t decideSpeculativeMove(const Grid &board, const uint8_t heads[4][2], const uint8_t headings[4])
+{
+    return decideMove(board, heads, headings, true);
+}
+} // namespace
+
+void TunedStrategy::start(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], uint8_t me)
+{
+    (void)me;
+    (void)grid;
+    openingBookStart(heads);
+}
+
+void TunedStrategy::step(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2], const uint8_t steps[NUM_PLAYERS],
+                         uint8_t me)
+{
+    (void)grid;
+    (void)heads;
+    openingBookFollow(steps, me);
+}
+
+uint8_t TunedStrategy::decide(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2],
+                              const uint8_t headings[NUM_PLAYERS], uint8_t me)
+{
+    // Book move in the opening, precomputed in loop() if the opponents moved as predicted,
+    // otherwise evaluate now
+    uint8_t best_direction = 0;
+    if (!openingBookMove(grid, heads[me], headings[me], best_direction) && !speculationLookup(heads, best_direction))
+        best_direction = decideMove(grid, heads, headings, false);
+    return best_direction;
+}
+
+void TunedStrategy::moveSent(const Grid &grid, const uint8_t heads[NUM_PLAYERS][2],
+                             const uint8_t headings[NUM_PLAYERS], uint8_t me, uint8_t direction)
+{
+    speculationPrepare(grid, heads, headings, me, direction);
+}
+
+void TunedStrategy::released(const Grid &grid, uint8_t player, const Trace &trace)
+{
+    (void)grid;
+    (void)player;
+    (void)trace;
+
+    // The predicted grids still contain the removed trace
+    speculationInvalidate();
+}
+
+void TunedStrategy::finish()
+{
+    const SpeculationStats &stats = speculationStats();
+    uint32_t lookups = stats.hits + stats.notReady + stats.misses + stats.skipped;
+    Serial.printf("Speculation: %lu/%lu hits (%lu%%), %lu not ready, %lu misses, %lu skipped, %lu/%lu candidates evaluated\n",
+                  (unsigned long)stats.hits, (unsigned long)lookups,
+                  (unsigned long)(lookups ? 100 * stats.hits / lookups : 0), (unsigned long)stats.notReady,
+                  (unsigned long)stats.misses, (unsigned long)stats.skipped, (unsigned long)stats.evaluated,
+                  (unsigned long)stats.prepared);
+    speculationResetStats();
+    speculationInvalidate();
+    Serial.printf("Opening book: %u moves\n", openingBookMoves());
+    const EndgameStats &endgame = endgameStats();
+    Serial.printf("Endgame: %lu sealed decisions, %lu cached, %lu solved, %lu stopped by the node limit\n",
+                  (unsigned long)endgame.sealed, (unsigned long)endgame.hits, (unsigned long)endgame.solved,
+                  (unsigned long)endgame.aborted);
+    endgameResetStats();
+}
+
+bool TunedStrategy::idle()
+{
+    return speculationStep(decideSpeculativeMove);
+}
@@ -5,18 +5,23 @@
  *
  * This file contains the Arduino setup and loop functions.
  * The program uses an event-driven architecture where the main processing
- * happens in response to CAN bus messages rather than in the main loop.
+ * happens in response to CAN bus messages. The main loop only uses the idle
+ * time between messages for speculative precomputation.
  */
 
 #include <Arduino.h>
 #include "CANHandler.h"
 #include "GameLogic.h"
+#include "MemoryWatch.h"
+#include "Profiler.h"
 
 
 void setup()
 {
     // Initialize serial for debugging output at 115200 baud
     Serial.begin(115200);
+    PROFILE_INIT();
+    MEMWATCH_INIT();
     // Uncomment to wait for serial monitor connection before continuing
     // while (!Serial);
 
@@ -44,6 +49,7 @@ void setup()
 
 void loop()
 {
-    // Program logic is handled by CAN message callbacks
-    // Keeping this empty improves responsiveness to incoming messages
+    // Program logic is handled by CAN message callbacks, which preempt this at any time.
+    // In between, precompute our answers to the most likely next game states.
+    speculateNextMove();
 }
\ No newline at end of file